@@ -0,0 +1,46 @@
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "../prog/simulation/batch_runner.h"
+
+// Plays the same batch on 1, 2, 4, ... threads up to the core count
+// and prints the speedup over the single-threaded run.
+int main(int argc, char** argv) {
+
+    batch_settings settings;
+    settings.m_level = argc > 1 ? std::atoi(argv[1]) : 5;
+    settings.m_games = argc > 2 ? std::atoi(argv[2]) : 2000;
+    settings.m_seed = 1;
+    settings.m_max_turns = 2000;
+
+    auto policies = [](std::uint64_t seed) { return move_policies::random(seed); };
+
+    int cores = std::max(1u, std::thread::hardware_concurrency());
+    double single = 0;
+
+    std::cout << "level " << settings.m_level << ", " << settings.m_games << " games, " << cores << " cores\n";
+
+    for (int threads = 1;; threads *= 2) {
+        if (threads > cores)
+            threads = cores;
+
+        batch_stats stats;
+        batch_runner runner (threads);
+
+        auto start = std::chrono::steady_clock::now();
+        runner.run(settings, policies, stats);
+        auto finish = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(finish - start).count();
+
+        if (threads == 1)
+            single = seconds;
+
+        std::cout << "  " << threads << " threads: " << seconds << " s, "
+                  << stats.m_turns / seconds << " turns/sec, speedup " << single / seconds
+                  << "x, efficiency " << single / seconds / threads * 100 << "%\n";
+
+        if (threads == cores)
+            break;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include <chrono>
+#include <iostream>
+
+#include "../lib/utils/type_utils.h"
+#include "../lib/utils/random/Pcg32.h"
+#include "../prog/simulation/simulation.h"
+
+// Classifies the occupants of a field-sized grid the way the turn loop does
+// (enemy? character? artifact?), once through RTTI and once through the kind tag,
+// then reports the per-turn time of a whole headless game for scale.
+
+template <typename F>
+double measure(const char* name, int repeats, F f) {
+    long long check = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeats; ++i)
+        check += f();
+    auto finish = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(finish - start).count() / repeats;
+    std::cout << "  " << name << ": " << ns << " ns/pass (checksum " << check << ")\n";
+    return ns;
+}
+
+int main(int argc, char** argv) {
+
+    const int cells = 64 * 64;
+
+    Pcg32 rng (1);
+    Vector<entity*> grid (cells);
+    for (int i = 0; i < cells; ++i) {
+        switch (rng.next(8)) {
+            case 0:
+                grid.add(new enemy(rng.next_bool() ? enemy::ZOMBIE : enemy::SKELETON));
+                break;
+            case 1:
+                grid.add(new artifact((artifact::artifact_id) rng.next(artifact::COUNT)));
+                break;
+            case 2:
+                grid.add(new player());
+                break;
+            default:
+                grid.add(nullptr);
+                break;
+        }
+    }
+
+    const int repeats = 20000;
+    std::cout << "dispatch over " << cells << " cells:\n";
+
+    double rtti_ns = measure("dynamic_cast/typeid", repeats, [&]() {
+        long long sum = 0;
+        for (const entity* e : grid) {
+            if (e == nullptr)
+                continue;
+            sum += type_utils::instanceof<enemy>(*e);
+            sum += type_utils::instanceof<character>(*e) * 2;
+            sum += type_utils::instanceof<artifact>(*e) * 4;
+            sum += typeid(*e) == typeid(enemy);
+        }
+        return sum;
+    });
+    double tag_ns = measure("kind tag          ", repeats, [&]() {
+        long long sum = 0;
+        for (const entity* e : grid) {
+            if (e == nullptr)
+                continue;
+            sum += e->is<enemy>();
+            sum += e->is<character>() * 2;
+            sum += e->is<artifact>() * 4;
+            sum += e->is<enemy>();
+        }
+        return sum;
+    });
+    std::cout << "  speedup: " << rtti_ns / tag_ns << "x\n";
+
+    for (entity* e : grid)
+        delete e;
+
+    int level = argc > 1 ? std::atoi(argv[1]) : 5;
+    long long turns = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::uint64_t seed = 0; seed < 200; ++seed) {
+        simulation sim (level, move_policies::random(seed), 2000, seed);
+        turns += sim.run().m_turns;
+    }
+    auto finish = std::chrono::steady_clock::now();
+    std::cout << "level " << level << ": " << std::chrono::duration<double, std::micro>(finish - start).count() / turns
+              << " us/turn over " << turns << " turns\n";
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+
+#include "../prog/field/field.h"
+#include "../prog/simulation/move_policy.h"
+
+// Time per turn on one level without a logger, with the synchronous text
+// FileLogger, with the AsyncLogger writing the same text (blocking on overflow,
+// so both write every record) and with the BinaryLogger; plus the log sizes.
+// Best of a few runs, the numbers are noisy otherwise.
+template <typename F>
+double measure(const char* name, int level, int turns, F make_logger, const char* filename) {
+    const int repeats = 3;
+    double best = 0;
+    for (int r = 0; r < repeats; ++r) {
+        field f (level, nullptr, false, 1);
+        f.set_logger(make_logger());
+        move_policy policy = move_policies::random(1);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < turns; ++i) {
+            f.send_sygnal(policy(f));
+            if (f.get_game_condition() != game_condition::RUNNING)
+                f.send_sygnal(sygnal::RESTART);
+        }
+        auto finish = std::chrono::steady_clock::now();
+
+        double us = std::chrono::duration<double, std::micro>(finish - start).count() / turns;
+        if (r == 0 || us < best)
+            best = us;
+    }
+    // the field held the last reference: the log is complete by now
+    std::cout << "  " << name << ": " << best << " us/turn";
+    if (filename != nullptr)
+        std::cout << ", " << std::filesystem::file_size(filename) << " bytes";
+    std::cout << '\n';
+    return best;
+}
+
+int main(int argc, char** argv) {
+
+    int level = argc > 1 ? std::atoi(argv[1]) : 5;
+    int turns = argc > 2 ? std::atoi(argv[2]) : 20000;
+    const char* filename = "log_bench.txt";
+    const char* binary_filename = "log_bench.glog";
+
+    std::cout << "level " << level << ", " << turns << " turns\n";
+
+    double none = measure("no logger   ", level, turns, []() {
+        return std::shared_ptr<Logger>();
+    }, nullptr);
+    double sync = measure("FileLogger  ", level, turns, [&]() {
+        return std::make_shared<FileLogger>(filename);
+    }, filename);
+    double async = measure("AsyncLogger ", level, turns, [&]() {
+        return std::make_shared<AsyncLogger>(filename, AsyncLogger::default_capacity, AsyncLogger::BLOCK);
+    }, filename);
+    double binary = measure("BinaryLogger", level, turns, [&]() {
+        return std::make_shared<BinaryLogger>(binary_filename);
+    }, binary_filename);
+
+    std::cout << "  logging overhead: sync " << sync - none << " us/turn, async " << async - none
+              << " us/turn, binary " << binary - none << " us/turn\n";
+
+    std::remove(filename);
+    std::remove(binary_filename);
+}
\ No newline at end of file
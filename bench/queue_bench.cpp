@@ -0,0 +1,85 @@
+#include <chrono>
+#include <iostream>
+
+#include "../lib/containers/list/List.h"
+#include "../lib/containers/queue/Queue.h"
+#include "../lib/containers/matrix/Matrix.h"
+#include "../lib/containers/pair/Pair.h"
+
+// The List-backed queue Queue<T> used to be, kept here as the baseline.
+template <typename T>
+class ListQueue {
+    List<T> m_list;
+public:
+    void push(const T& t) { m_list.add(t); }
+    T pop() { T t = m_list.first(); m_list.remove_first(); return t; }
+    bool empty() { return m_list.empty(); }
+};
+
+using point = Pair<int>;
+
+template <typename Q>
+long long bfs(Q& q, Matrix<int>& distances) {
+    long long sum = 0;
+    distances.fill(-1);
+    distances[0][0] = 0;
+    q.push({ 0, 0 });
+    while (!q.empty()) {
+        point cur = q.pop();
+        int d = distances[cur.first][cur.second];
+        sum += d;
+        const point neighbors[] = {
+                { cur.first - 1, cur.second },
+                { cur.first, cur.second - 1 },
+                { cur.first + 1, cur.second },
+                { cur.first, cur.second + 1 }
+        };
+        for (const point& n : neighbors) {
+            if (n.first < 0 || n.first >= distances.width() || n.second < 0 || n.second >= distances.height())
+                continue;
+            if (distances[n.first][n.second] != -1)
+                continue;
+            distances[n.first][n.second] = d + 1;
+            q.push(n);
+        }
+    }
+    return sum;
+}
+
+template <typename F>
+double measure(const char* name, int repeats, F f) {
+    long long check = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeats; ++i)
+        check += f();
+    auto finish = std::chrono::steady_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(finish - start).count() / repeats;
+    std::cout << "  " << name << ": " << ms << " ms/run (checksum " << check << ")\n";
+    return ms;
+}
+
+int main() {
+
+    const int sizes[] = { 27, 256, 1024 };
+
+    for (int size : sizes) {
+        int repeats = size < 100 ? 20000 : size < 500 ? 200 : 10;
+        Matrix<int> distances (size, size);
+        std::cout << "bfs " << size << "x" << size << ":\n";
+
+        double list_ms = measure("List queue ", repeats, [&]() {
+            ListQueue<point> q;
+            return bfs(q, distances);
+        });
+        double ring_ms = measure("ring Queue ", repeats, [&]() {
+            Queue<point> q;
+            return bfs(q, distances);
+        });
+        FixedQueue<point> fixed (size * size);
+        double fixed_ms = measure("FixedQueue ", repeats, [&]() {
+            return bfs(fixed, distances);
+        });
+
+        std::cout << "  speedup: ring " << list_ms / ring_ms << "x, fixed " << list_ms / fixed_ms << "x\n";
+    }
+}
\ No newline at end of file
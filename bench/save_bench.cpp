@@ -0,0 +1,150 @@
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include "../prog/field/field.h"
+#include "../prog/simulation/move_policy.h"
+#include "../lib/utils/sarialization/binary_file.h"
+
+// Save and load latency of the text and the binary formats through a file,
+// plus the file sizes; what keeping a turn journal adds to a turn; then how
+// long the field takes to resume from a mapped binary save of a huge level.
+// Best of a few runs, the numbers are noisy otherwise.
+template <typename F>
+double measure(int iterations, F body) {
+    const int repeats = 3;
+    double best = 0;
+    for (int r = 0; r < repeats; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+            body();
+        auto finish = std::chrono::steady_clock::now();
+
+        double us = std::chrono::duration<double, std::micro>(finish - start).count() / iterations;
+        if (r == 0 || us < best)
+            best = us;
+    }
+    return best;
+}
+
+// A level of side x side cells in the layout of binary save version 3:
+// walls around, ground inside, the player in a corner and nobody else.
+void write_huge_save(const char* filename, int side) {
+    binary_writer out;
+    binary_file::begin(out);
+    for (int value : { 0, side, side, 1, 1, side - 2, side - 2 })
+        out.write<std::int32_t>(value);
+    out.write<std::uint8_t>(1);
+    out.write<std::uint8_t>(0);
+    Pcg32(1).save(out);
+    for (int x = 0; x < side; ++x)
+        for (int y = 0; y < side; ++y)
+            out.write<std::uint8_t>(x == 0 || y == 0 || x == side - 1 || y == side - 1 ? cell::WALL : cell::GROUND);
+    player({ 1, 1 }).save(out);
+    out.write<std::uint32_t>(0);
+    out.write<std::uint32_t>(0);
+    binary_file::finish(out, "GFLD", 3);
+    std::ofstream file(filename, std::ios::binary);
+    file.write(out.data(), (std::streamsize) out.size());
+}
+
+int main(int argc, char** argv) {
+
+    int level = argc > 1 ? std::atoi(argv[1]) : 5;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 2000;
+    const char* filename = "save_bench.txt";
+    const char* binary_filename = "save_bench.bin";
+    const char magic[] = "BNCH";
+
+    field f (level, nullptr, false, 1);
+    for (int i = 0; i < 10; ++i)
+        f.send_sygnal(sygnal::STEP);
+
+    std::cout << "level " << level << ", " << iterations << " iterations\n";
+
+    double text_save = measure(iterations, [&]() {
+        std::ofstream out(filename);
+        f.save(out);
+    });
+    double text_load = measure(iterations, [&]() {
+        std::ifstream in(filename);
+        f.load(in);
+    });
+    std::cout << "  text  : save " << text_save << " us, load " << text_load << " us, "
+              << std::filesystem::file_size(filename) << " bytes\n";
+
+    double binary_save = measure(iterations, [&]() {
+        binary_writer buffer;
+        binary_file::begin(buffer);
+        f.save(buffer);
+        binary_file::finish(buffer, magic, 1);
+        std::ofstream out(binary_filename, std::ios::binary);
+        out.write(buffer.data(), (std::streamsize) buffer.size());
+    });
+    double binary_load = measure(iterations, [&]() {
+        std::ifstream in(binary_filename, std::ios::binary);
+        std::string data = binary_file::read_all(in);
+        binary_reader reader = binary_file::open(data.data(), data.size(), magic, 1);
+        f.load(reader);
+    });
+    std::cout << "  binary: save " << binary_save << " us, load " << binary_load << " us, "
+              << std::filesystem::file_size(binary_filename) << " bytes\n";
+
+    // what save_service costs the game thread, the rest happens on its worker
+    double capture = measure(iterations, [&]() {
+        save_snapshot snap = f.capture_save();
+    });
+    std::cout << "  background save, game thread: " << capture << " us\n";
+
+    std::remove(filename);
+    std::remove(binary_filename);
+
+    const char* journal_filename = "save_bench.journal";
+    auto play = [&](bool journal) {
+        field game (level, nullptr, false, 1);
+        if (journal)
+            game.set_journal(std::make_shared<turn_journal>(journal_filename));
+        move_policy policy = move_policies::random(1);
+        for (int i = 0; i < iterations; ++i) {
+            game.send_sygnal(policy(game));
+            if (game.get_game_condition() != game_condition::RUNNING)
+                game.send_sygnal(sygnal::RESTART);
+        }
+    };
+    double plain_turn = measure(1, [&]() { play(false); }) / iterations;
+    double journal_turn = measure(1, [&]() { play(true); }) / iterations;
+    std::cout << "  turn journal: +" << journal_turn - plain_turn << " us/turn, "
+              << std::filesystem::file_size(journal_filename) << " bytes after the last checkpoint\n";
+    std::remove(journal_filename);
+
+    // the field resumes from field_save.bin in the working directory
+    int side = argc > 3 ? std::atoi(argv[3]) : 2000;
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "save_bench";
+    std::filesystem::create_directories(directory);
+    std::filesystem::path previous = std::filesystem::current_path();
+    std::filesystem::current_path(directory);
+    write_huge_save("field_save.bin", side);
+
+    double resume = measure(5, [&]() {
+        field huge (0, nullptr, true);
+        if (huge.width() != side)
+            std::cout << "  the huge save was not loaded\n";
+    });
+    std::cout << "  resume " << side << "x" << side << " from a mapped save: " << resume / 1000 << " ms, "
+              << std::filesystem::file_size("field_save.bin") << " bytes\n";
+
+    field huge (0, nullptr, true);
+    double huge_capture = measure(iterations, [&]() {
+        save_snapshot snap = huge.capture_save();
+    });
+    double huge_save = measure(5, [&]() {
+        field::write_save(huge.capture_save());
+    });
+    std::cout << "  background save of it, game thread: " << huge_capture << " us, worker: "
+              << huge_save / 1000 << " ms\n";
+
+    std::filesystem::current_path(previous);
+    std::filesystem::remove_all(directory);
+}
\ No newline at end of file
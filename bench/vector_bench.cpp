@@ -0,0 +1,120 @@
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "../lib/containers/vector/Vector.h"
+
+struct info {
+    int m_id;
+    int m_hp;
+    std::function<int(int)> m_strategy;
+};
+
+template <typename F>
+double measure(int repeats, F f) {
+    long long check = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeats; ++i)
+        check += f();
+    auto finish = std::chrono::steady_clock::now();
+    if (check == 42)
+        std::cout << "";
+    return std::chrono::duration<double, std::milli>(finish - start).count() / repeats;
+}
+
+template <typename F1, typename F2>
+void compare(const char* name, int repeats, F1 mine, F2 std_version) {
+    double mine_ms = measure(repeats, mine);
+    double std_ms = measure(repeats, std_version);
+    std::cout << name << ": Vector " << mine_ms << " ms, std::vector " << std_ms << " ms (ratio " << mine_ms / std_ms << ")\n";
+}
+
+int main() {
+
+    const int n = 1000000;
+
+    compare("add int x1M", 20, [&]() {
+        Vector<int> v (0);
+        for (int i = 0; i < n; ++i)
+            v.add(i);
+        return (long long) v.size();
+    }, [&]() {
+        std::vector<int> v;
+        for (int i = 0; i < n; ++i)
+            v.push_back(i);
+        return (long long) v.size();
+    });
+
+    auto shared = std::make_shared<int>(1);
+    compare("add shared_ptr x100k", 20, [&]() {
+        Vector<std::shared_ptr<int>> v (0);
+        for (int i = 0; i < n / 10; ++i)
+            v.add(shared);
+        return (long long) shared.use_count();
+    }, [&]() {
+        std::vector<std::shared_ptr<int>> v;
+        for (int i = 0; i < n / 10; ++i)
+            v.push_back(shared);
+        return (long long) shared.use_count();
+    });
+
+    compare("emplace std::function struct x100k", 20, [&]() {
+        Vector<info> v (0);
+        for (int i = 0; i < n / 10; ++i)
+            v.emplace(info{ i, i, [](int x) { return x + 1; } });
+        return (long long) v.size();
+    }, [&]() {
+        std::vector<info> v;
+        for (int i = 0; i < n / 10; ++i)
+            v.emplace_back(info{ i, i, [](int x) { return x + 1; } });
+        return (long long) v.size();
+    });
+
+    compare("remove(0) shared_ptr x10k", 5, [&]() {
+        Vector<std::shared_ptr<int>> v (0);
+        for (int i = 0; i < n / 100; ++i)
+            v.add(shared);
+        while (!v.empty())
+            v.remove(0);
+        return (long long) v.size();
+    }, [&]() {
+        std::vector<std::shared_ptr<int>> v;
+        for (int i = 0; i < n / 100; ++i)
+            v.push_back(shared);
+        while (!v.empty())
+            v.erase(v.begin());
+        return (long long) v.size();
+    });
+
+    compare("swap_remove(0) shared_ptr x100k", 20, [&]() {
+        Vector<std::shared_ptr<int>> v (0);
+        for (int i = 0; i < n / 10; ++i)
+            v.add(shared);
+        while (!v.empty())
+            v.swap_remove(0);
+        return (long long) v.size();
+    }, [&]() {
+        std::vector<std::shared_ptr<int>> v;
+        for (int i = 0; i < n / 10; ++i)
+            v.push_back(shared);
+        while (!v.empty()) {
+            v.front() = std::move(v.back());
+            v.pop_back();
+        }
+        return (long long) v.size();
+    });
+
+    compare("copy Vector<int> x1M", 20, [&]() {
+        static Vector<int> source (0);
+        if (source.empty())
+            source.resize(n);
+        Vector<int> copy (source);
+        return (long long) copy.size();
+    }, [&]() {
+        static std::vector<int> source (n);
+        std::vector<int> copy (source);
+        return (long long) copy.size();
+    });
+}
\ No newline at end of file
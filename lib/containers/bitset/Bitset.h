@@ -0,0 +1,183 @@
+#ifndef CPP_MY_LIB_BITSET_H
+#define CPP_MY_LIB_BITSET_H
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+// Runtime-sized bitset packed into 64-bit words.
+// Like Matrix, resize keeps the allocation when the new size fits into it.
+class Bitset {
+
+public:
+
+    using word_type = std::uint64_t;
+
+    static constexpr int word_bits = 64;
+
+private:
+
+    word_type* m_words = nullptr;
+    int m_size = 0;
+    int m_capacity = 0; // in words
+
+    static int words_for(int bits);
+
+    void __copy(const Bitset& other);
+    void __move(Bitset&& other);
+    void __free();
+
+public:
+
+    explicit Bitset(int size = 0);
+    Bitset(const Bitset& other);
+    Bitset(Bitset&& other);
+
+    ~Bitset();
+
+    int size() const;
+    int words() const;
+
+    // all bits are cleared after resize
+    void resize(int size);
+
+    bool test(int index) const;
+    void set(int index);
+    void set(int index, bool value);
+    void reset(int index);
+
+    void fill(bool value);
+    int count() const;
+
+    word_type* data();
+    const word_type* data() const;
+
+    Bitset& operator=(const Bitset& other);
+    Bitset& operator=(Bitset&& other);
+
+    friend std::ostream& operator<<(std::ostream& out, const Bitset& b);
+};
+
+inline int Bitset::words_for(int bits) {
+    return (bits + word_bits - 1) / word_bits;
+}
+
+inline void Bitset::__copy(const Bitset& other) {
+    resize(other.m_size);
+    std::memcpy(m_words, other.m_words, sizeof(word_type) * words());
+}
+
+inline void Bitset::__move(Bitset&& other) {
+    __free();
+    m_words = other.m_words;
+    m_size = other.m_size;
+    m_capacity = other.m_capacity;
+    other.m_words = nullptr;
+    other.m_size = other.m_capacity = 0;
+}
+
+inline void Bitset::__free() {
+    delete[] m_words;
+    m_words = nullptr;
+    m_size = m_capacity = 0;
+}
+
+inline Bitset::Bitset(int size) {
+    resize(size);
+}
+
+inline Bitset::Bitset(const Bitset& other) {
+    __copy(other);
+}
+
+inline Bitset::Bitset(Bitset&& other) {
+    __move(std::move(other));
+}
+
+inline Bitset::~Bitset() {
+    __free();
+}
+
+inline int Bitset::size() const {
+    return m_size;
+}
+
+inline int Bitset::words() const {
+    return words_for(m_size);
+}
+
+inline void Bitset::resize(int size) {
+    if (words_for(size) > m_capacity) {
+        __free();
+        m_capacity = words_for(size);
+        m_words = new word_type[m_capacity];
+    }
+    m_size = size;
+    fill(false);
+}
+
+inline bool Bitset::test(int index) const {
+    return (m_words[index / word_bits] >> (index % word_bits)) & 1;
+}
+
+inline void Bitset::set(int index) {
+    m_words[index / word_bits] |= word_type(1) << (index % word_bits);
+}
+
+inline void Bitset::set(int index, bool value) {
+    if (value)
+        set(index);
+    else
+        reset(index);
+}
+
+inline void Bitset::reset(int index) {
+    m_words[index / word_bits] &= ~(word_type(1) << (index % word_bits));
+}
+
+// bits past size() stay zero, so count() can look at whole words
+inline void Bitset::fill(bool value) {
+    if (words() == 0)
+        return;
+    std::memset(m_words, value ? 0xff : 0, sizeof(word_type) * words());
+    if (value && m_size % word_bits != 0)
+        m_words[words() - 1] = (word_type(1) << (m_size % word_bits)) - 1;
+}
+
+inline int Bitset::count() const {
+    int result = 0;
+    for (int i = 0; i < words(); ++i)
+        result += __builtin_popcountll(m_words[i]);
+    return result;
+}
+
+inline Bitset::word_type* Bitset::data() {
+    return m_words;
+}
+
+inline const Bitset::word_type* Bitset::data() const {
+    return m_words;
+}
+
+inline Bitset& Bitset::operator=(const Bitset& other) {
+    if (this != &other) {
+        __copy(other);
+    }
+    return *this;
+}
+
+inline Bitset& Bitset::operator=(Bitset&& other) {
+    if (this != &other) {
+        __move(std::move(other));
+    }
+    return *this;
+}
+
+inline std::ostream& operator<<(std::ostream& out, const Bitset& b) {
+    for (int i = 0; i < b.size(); ++i)
+        out << (b.test(i) ? '1' : '0');
+    return out;
+}
+
+#endif //CPP_MY_LIB_BITSET_H
\ No newline at end of file
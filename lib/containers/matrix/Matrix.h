@@ -2,39 +2,90 @@
 #define CPP_MY_LIB_MATRIX_H
 
 #include <iostream>
+#include <algorithm>
+#include <span>
 
 #include "../vector/Vector.h"
+#include "MatrixView.h"
 
+template <typename T>
+class MatrixColumnIterator {
+
+    T* m_cur;
+    int m_height;
+
+public:
+
+    MatrixColumnIterator(T* start, int height);
+
+    MatrixView<T> operator*() const;
+
+    MatrixColumnIterator<T>& operator++();
+    MatrixColumnIterator<T> operator++(int);
+
+    MatrixColumnIterator<T>& operator--();
+    MatrixColumnIterator<T> operator--(int);
+
+    bool operator==(const MatrixColumnIterator<T>& other) const;
+    bool operator!=(const MatrixColumnIterator<T>& other) const;
+};
+
+// Width x height matrix kept in one contiguous column-major allocation:
+// element (x, y) lives at data()[x * height() + y], so m[x] is a contiguous
+// column and m.row(y) is a view strided by height().
 template <typename T>
 class Matrix {
 
 public:
-    using Column = Vector<T>;
+    using Column = MatrixView<T>;
+    using ConstColumn = MatrixView<const T>;
+    using Row = MatrixView<T>;
+    using ConstRow = MatrixView<const T>;
 
-    using Iterator = typename Vector<Column>::Iterator;
-    using ConstIterator = typename Vector<Column>::ConstIterator;
-    using RIterator = typename Vector<Column>::RIterator;
-    using RConstIterator = typename Vector<Column>::RConstIterator;
+    using Iterator = MatrixColumnIterator<T>;
+    using ConstIterator = MatrixColumnIterator<const T>;
 
 private:
     int m_width = 0, m_height = 0;
-    Vector<Column> m_matr{};
+    int m_capacity = 0;
+    T* m_data = nullptr;
 
     void __copy(const Matrix<T>& other);
     void __move(Matrix<T>&& other);
+    void __free();
 
 public:
 
     Matrix(int width, int height);
-    Matrix(const std::initializer_list<Column>& initializerList);
+    Matrix(const std::initializer_list<Vector<T>>& initializerList);
     Matrix(const Matrix<T>& other);
     Matrix(Matrix<T>&& other);
 
+    ~Matrix();
+
     int width() const;
     int height() const;
+    int size() const;
+
+    void resize(int width, int height);
+    void fill(const T& value);
+
+    T* data();
+    const T* data() const;
+
+    std::span<T> span();
+    std::span<const T> span() const;
 
-    Column& operator[](int index);
-    const Column& operator[](int index) const;
+    T& operator()(int x, int y);
+    const T& operator()(int x, int y) const;
+
+    Column operator[](int index);
+    ConstColumn operator[](int index) const;
+
+    Column column(int x);
+    ConstColumn column(int x) const;
+    Row row(int y);
+    ConstRow row(int y) const;
 
     Matrix<T>& operator=(const std::initializer_list<Vector<T>>& initializerList);
     Matrix<T>& operator=(const Matrix<T>& other);
@@ -45,44 +96,89 @@ public:
 
     Iterator begin();
     Iterator end();
-    RIterator rbegin();
-    RIterator rend();
-    Iterator from(int index);
-    RIterator rfrom(int index);
 
     ConstIterator begin() const;
     ConstIterator end() const;
-    RConstIterator rbegin() const;
-    RConstIterator rend() const;
-    ConstIterator from(int index) const;
-    RConstIterator rfrom(int index) const;
 };
 
+template <typename T>
+MatrixColumnIterator<T>::MatrixColumnIterator(T* start, int height) : m_cur(start), m_height(height) {}
+
+template <typename T>
+MatrixView<T> MatrixColumnIterator<T>::operator*() const {
+    return MatrixView<T>(m_cur, m_height);
+}
+
+template <typename T>
+MatrixColumnIterator<T>& MatrixColumnIterator<T>::operator++() {
+    m_cur += m_height;
+    return *this;
+}
+
+template <typename T>
+MatrixColumnIterator<T> MatrixColumnIterator<T>::operator++(int) {
+    MatrixColumnIterator<T> tmp(m_cur, m_height);
+    m_cur += m_height;
+    return tmp;
+}
+
+template <typename T>
+MatrixColumnIterator<T>& MatrixColumnIterator<T>::operator--() {
+    m_cur -= m_height;
+    return *this;
+}
+
+template <typename T>
+MatrixColumnIterator<T> MatrixColumnIterator<T>::operator--(int) {
+    MatrixColumnIterator<T> tmp(m_cur, m_height);
+    m_cur -= m_height;
+    return tmp;
+}
+
+template <typename T>
+bool MatrixColumnIterator<T>::operator==(const MatrixColumnIterator<T>& other) const {
+    return m_cur == other.m_cur;
+}
+
+template <typename T>
+bool MatrixColumnIterator<T>::operator!=(const MatrixColumnIterator<T>& other) const {
+    return !operator==(other);
+}
+
 template <typename T>
 void Matrix<T>::__copy(const Matrix<T>& other) {
-    m_width = other.m_width;
-    m_height = other.m_height;
-    m_matr = other.m_matr;
+    resize(other.m_width, other.m_height);
+    for (int i = 0; i < size(); ++i)
+        m_data[i] = other.m_data[i];
 }
 
 template <typename T>
 void Matrix<T>::__move(Matrix<T>&& other) {
+    __free();
     m_width = other.m_width;
     m_height = other.m_height;
-    m_matr = std::move(other.m_matr);
+    m_capacity = other.m_capacity;
+    m_data = other.m_data;
     other.m_width = 0;
     other.m_height = 0;
+    other.m_capacity = 0;
+    other.m_data = nullptr;
 }
 
 template <typename T>
-Matrix<T>::Matrix(int width, int height) : m_width(width), m_height(height), m_matr(width) {
-    m_matr.resize(width);
-    for (Column& c : m_matr)
-        c.resize(height);
+void Matrix<T>::__free() {
+    delete[] m_data;
+    m_data = nullptr;
+    m_width = m_height = m_capacity = 0;
 }
 
 template <typename T>
-Matrix<T>::Matrix(const std::initializer_list<Column>& initializerList) {
+Matrix<T>::Matrix(int width, int height) {
+    resize(width, height);
+}
+
+template <typename T>
+Matrix<T>::Matrix(const std::initializer_list<Vector<T>>& initializerList) {
     operator=(initializerList);
 }
 
@@ -96,6 +192,11 @@ Matrix<T>::Matrix(Matrix<T>&& other) {
     __move(std::move(other));
 }
 
+template <typename T>
+Matrix<T>::~Matrix() {
+    __free();
+}
+
 template <typename T>
 int Matrix<T>::width() const {
     return m_width;
@@ -107,28 +208,100 @@ int Matrix<T>::height() const {
 }
 
 template <typename T>
-typename Matrix<T>::Column& Matrix<T>::operator[](int index) {
-    return m_matr[index];
+int Matrix<T>::size() const {
+    return m_width * m_height;
+}
+
+// Keeps the allocation when the new size fits into it,
+// so the contents are unspecified after resize.
+template <typename T>
+void Matrix<T>::resize(int width, int height) {
+    if (width * height > m_capacity) {
+        __free();
+        m_capacity = width * height;
+        m_data = new T[m_capacity]{};
+    }
+    m_width = width;
+    m_height = height;
 }
 
 template <typename T>
-const typename Matrix<T>::Column& Matrix<T>::operator[](int index) const {
-    return m_matr[index];
+void Matrix<T>::fill(const T& value) {
+    std::fill(m_data, m_data + size(), value);
+}
+
+template <typename T>
+T* Matrix<T>::data() {
+    return m_data;
+}
+
+template <typename T>
+const T* Matrix<T>::data() const {
+    return m_data;
+}
+
+template <typename T>
+std::span<T> Matrix<T>::span() {
+    return std::span<T>(m_data, size());
+}
+
+template <typename T>
+std::span<const T> Matrix<T>::span() const {
+    return std::span<const T>(m_data, size());
+}
+
+template <typename T>
+T& Matrix<T>::operator()(int x, int y) {
+    return m_data[x * m_height + y];
+}
+
+template <typename T>
+const T& Matrix<T>::operator()(int x, int y) const {
+    return m_data[x * m_height + y];
+}
+
+template <typename T>
+typename Matrix<T>::Column Matrix<T>::operator[](int index) {
+    return column(index);
+}
+
+template <typename T>
+typename Matrix<T>::ConstColumn Matrix<T>::operator[](int index) const {
+    return column(index);
+}
+
+template <typename T>
+typename Matrix<T>::Column Matrix<T>::column(int x) {
+    return Column(m_data + x * m_height, m_height);
+}
+
+template <typename T>
+typename Matrix<T>::ConstColumn Matrix<T>::column(int x) const {
+    return ConstColumn(m_data + x * m_height, m_height);
+}
+
+template <typename T>
+typename Matrix<T>::Row Matrix<T>::row(int y) {
+    return Row(m_data + y, m_width, m_height);
+}
+
+template <typename T>
+typename Matrix<T>::ConstRow Matrix<T>::row(int y) const {
+    return ConstRow(m_data + y, m_width, m_height);
 }
 
 template <typename T>
 Matrix<T>& Matrix<T>::operator=(const std::initializer_list<Vector<T>>& initializerList) {
     if (initializerList.size() == 0) {
-        m_width = m_height = 0;
-        m_matr.resize(0);
+        resize(0, 0);
     } else {
-        m_width = initializerList.size();
-        m_height = (*initializerList.begin()).size();
-        m_matr.resize(m_width);
+        resize(initializerList.size(), (*initializerList.begin()).size());
         auto iter = initializerList.begin();
-        for (int i = 0; i < m_width; ++i, ++iter)
-            m_matr[i] = std::move(*iter);
+        for (int x = 0; x < m_width; ++x, ++iter)
+            for (int y = 0; y < m_height; ++y)
+                operator()(x, y) = (*iter)[y];
     }
+    return *this;
 }
 
 template <typename T>
@@ -149,68 +322,41 @@ Matrix<T>& Matrix<T>::operator=(Matrix<T>&& other) {
 
 template <typename R>
 std::ostream& operator<<(std::ostream& out, const Matrix<R>& m) {
-    out << "{ width=" << m.m_width << ", height=" << m.m_height << ", elements=" << m.m_matr << " }";
+    out << "{ width=" << m.m_width << ", height=" << m.m_height << ", elements=";
+    if (m.m_width == 0) {
+        out << "{}";
+    } else {
+        out << "{ ";
+        for (int x = 0;;) {
+            out << m.column(x);
+            if (++x == m.m_width)
+                break;
+            out << ", ";
+        }
+        out << " }";
+    }
+    out << " }";
     return out;
 }
 
 template<typename T>
 typename Matrix<T>::Iterator Matrix<T>::begin() {
-    return m_matr.begin();
+    return Iterator(m_data, m_height);
 }
 
 template<typename T>
 typename Matrix<T>::Iterator Matrix<T>::end() {
-    return m_matr.end();
-}
-
-template<typename T>
-typename Matrix<T>::RIterator Matrix<T>::rbegin() {
-    return m_matr.rbegin();
-}
-
-template<typename T>
-typename Matrix<T>::RIterator Matrix<T>::rend() {
-    return m_matr.rend();
-}
-
-template<typename T>
-typename Matrix<T>::Iterator Matrix<T>::from(int index) {
-    return m_matr.from(index);
-}
-
-template<typename T>
-typename Matrix<T>::RIterator Matrix<T>::rfrom(int index) {
-    return m_matr.rfrom(index);
+    return Iterator(m_data + size(), m_height);
 }
 
 template<typename T>
 typename Matrix<T>::ConstIterator Matrix<T>::begin() const {
-    return m_matr.begin();
+    return ConstIterator(m_data, m_height);
 }
 
 template<typename T>
 typename Matrix<T>::ConstIterator Matrix<T>::end() const {
-    return m_matr.end();
-}
-
-template<typename T>
-typename Matrix<T>::RConstIterator Matrix<T>::rbegin() const {
-    return m_matr.rbegin();
-}
-
-template<typename T>
-typename Matrix<T>::RConstIterator Matrix<T>::rend() const {
-    return m_matr.rend();
-}
-
-template<typename T>
-typename Matrix<T>::ConstIterator Matrix<T>::from(int index) const {
-    return m_matr.from(index);
-}
-
-template<typename T>
-typename Matrix<T>::RConstIterator Matrix<T>::rfrom(int index) const {
-    return m_matr.rfrom(index);
+    return ConstIterator(m_data + size(), m_height);
 }
 
 #endif //CPP_MY_LIB_MATRIX_H
\ No newline at end of file
@@ -0,0 +1,201 @@
+#ifndef CPP_MY_LIB_MATRIX_VIEW_H
+#define CPP_MY_LIB_MATRIX_VIEW_H
+
+#include <iostream>
+#include <iterator>
+
+template <typename T>
+class MatrixViewIterator {
+
+    T* m_cur;
+    int m_stride;
+
+public:
+
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_const_t<T>;
+    using difference_type = int;
+    using pointer = T*;
+    using reference = T&;
+
+    MatrixViewIterator(T* start, int stride);
+
+    T& operator*() const;
+
+    MatrixViewIterator<T> operator+(int n) const;
+    int operator-(const MatrixViewIterator<T>& other) const;
+
+    MatrixViewIterator<T>& operator++();
+    MatrixViewIterator<T> operator++(int);
+    MatrixViewIterator<T>& operator+=(int n);
+
+    MatrixViewIterator<T>& operator--();
+    MatrixViewIterator<T> operator--(int);
+    MatrixViewIterator<T>& operator-=(int n);
+
+    bool operator==(const MatrixViewIterator<T>& other) const;
+    bool operator!=(const MatrixViewIterator<T>& other) const;
+};
+
+// Non-owning strided view over a part of Matrix storage.
+// Columns are contiguous (stride 1), rows are strided by the matrix height.
+template <typename T>
+class MatrixView {
+
+    T* m_first;
+    int m_size;
+    int m_stride;
+
+public:
+
+    using Iterator = MatrixViewIterator<T>;
+
+    MatrixView(T* first, int size, int stride = 1);
+
+    int size() const;
+    int stride() const;
+    bool contiguous() const;
+
+    T* data() const;
+
+    T& operator[](int index) const;
+
+    template <typename R>
+    void fill(const R& value) const;
+
+    Iterator begin() const;
+    Iterator end() const;
+
+    template <typename R>
+    friend std::ostream& operator<<(std::ostream& out, const MatrixView<R>& v);
+};
+
+template <typename T>
+MatrixViewIterator<T>::MatrixViewIterator(T* start, int stride) : m_cur(start), m_stride(stride) {}
+
+template <typename T>
+T& MatrixViewIterator<T>::operator*() const {
+    return *m_cur;
+}
+
+template <typename T>
+MatrixViewIterator<T> MatrixViewIterator<T>::operator+(int n) const {
+    return MatrixViewIterator<T>(m_cur, m_stride) += n;
+}
+
+template <typename T>
+int MatrixViewIterator<T>::operator-(const MatrixViewIterator<T>& other) const {
+    return (m_cur - other.m_cur) / m_stride;
+}
+
+template <typename T>
+MatrixViewIterator<T>& MatrixViewIterator<T>::operator++() {
+    m_cur += m_stride;
+    return *this;
+}
+
+template <typename T>
+MatrixViewIterator<T> MatrixViewIterator<T>::operator++(int) {
+    MatrixViewIterator<T> tmp(m_cur, m_stride);
+    m_cur += m_stride;
+    return tmp;
+}
+
+template <typename T>
+MatrixViewIterator<T>& MatrixViewIterator<T>::operator+=(int n) {
+    m_cur += n * m_stride;
+    return *this;
+}
+
+template <typename T>
+MatrixViewIterator<T>& MatrixViewIterator<T>::operator--() {
+    m_cur -= m_stride;
+    return *this;
+}
+
+template <typename T>
+MatrixViewIterator<T> MatrixViewIterator<T>::operator--(int) {
+    MatrixViewIterator<T> tmp(m_cur, m_stride);
+    m_cur -= m_stride;
+    return tmp;
+}
+
+template <typename T>
+MatrixViewIterator<T>& MatrixViewIterator<T>::operator-=(int n) {
+    m_cur -= n * m_stride;
+    return *this;
+}
+
+template <typename T>
+bool MatrixViewIterator<T>::operator==(const MatrixViewIterator<T>& other) const {
+    return m_cur == other.m_cur;
+}
+
+template <typename T>
+bool MatrixViewIterator<T>::operator!=(const MatrixViewIterator<T>& other) const {
+    return !operator==(other);
+}
+
+template <typename T>
+MatrixView<T>::MatrixView(T* first, int size, int stride) : m_first(first), m_size(size), m_stride(stride) {}
+
+template <typename T>
+int MatrixView<T>::size() const {
+    return m_size;
+}
+
+template <typename T>
+int MatrixView<T>::stride() const {
+    return m_stride;
+}
+
+template <typename T>
+bool MatrixView<T>::contiguous() const {
+    return m_stride == 1;
+}
+
+template <typename T>
+T* MatrixView<T>::data() const {
+    return m_first;
+}
+
+template <typename T>
+T& MatrixView<T>::operator[](int index) const {
+    return m_first[index * m_stride];
+}
+
+template <typename T>
+template <typename R>
+void MatrixView<T>::fill(const R& value) const {
+    for (int i = 0; i < m_size; ++i)
+        m_first[i * m_stride] = value;
+}
+
+template <typename T>
+typename MatrixView<T>::Iterator MatrixView<T>::begin() const {
+    return Iterator(m_first, m_stride);
+}
+
+template <typename T>
+typename MatrixView<T>::Iterator MatrixView<T>::end() const {
+    return Iterator(m_first + m_size * m_stride, m_stride);
+}
+
+template <typename R>
+std::ostream& operator<<(std::ostream& out, const MatrixView<R>& v) {
+    if (v.size() == 0) {
+        out << "{}";
+        return out;
+    }
+    out << "{ ";
+    for (int i = 0;;) {
+        out << v[i];
+        if (++i == v.size())
+            break;
+        out << ", ";
+    }
+    out << " }";
+    return out;
+}
+
+#endif //CPP_MY_LIB_MATRIX_VIEW_H
\ No newline at end of file
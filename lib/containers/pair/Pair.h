@@ -5,6 +5,8 @@
 #include <utility>
 #include <cstring>
 
+#include "../../utils/memory_utils.h"
+
 template <typename T, typename R = T>
 class Pair {
 
@@ -111,4 +113,8 @@ std::ostream& operator<<(std::ostream& out, const Pair<T1, R1> p) {
     return out;
 }
 
+template <typename T, typename R>
+struct is_trivially_relocatable<Pair<T,R>>
+        : std::bool_constant<is_trivially_relocatable<T>::value && is_trivially_relocatable<R>::value> {};
+
 #endif //CPP_MY_LIB_PAIR_H
\ No newline at end of file
@@ -1,18 +1,52 @@
 #ifndef CPP_MY_LIB_QUEUE_H
 #define CPP_MY_LIB_QUEUE_H
 
-#include "../list/List.h"
+#include <new>
+#include <stdexcept>
+#include <utility>
 
+#include "../../utils/memory_utils.h"
+
+// FIFO queue on a circular buffer: push and pop never allocate
+// unless the buffer is full, in which case it doubles.
 template <typename T>
 class Queue {
 
+public:
+
+    static constexpr int initial_capacity = 16;
+
 protected:
 
-    List<T> m_list;
+    T* m_arr = nullptr;
+    int m_capacity = 0;
+    int m_head = 0;
+    int m_size = 0;
+    bool m_fixed = false;
+
+    Queue(int capacity, bool fixed);
+
+    void __copy(const Queue<T>& other);
+    void __move(Queue<T>&& other);
+    void __free();
+
+    void __reserve_more();
+    void assume_not_empty() const;
+    void assume_not_full();
+
+    int index(int i) const;
 
 public:
 
     Queue();
+    explicit Queue(int capacity);
+    Queue(const Queue<T>& other);
+    Queue(Queue<T>&& other);
+
+    ~Queue();
+
+    void reserve(int n);
+    void clear();
 
     void push(const T& t);
     void push(T&& t);
@@ -24,58 +58,218 @@ public:
     T& back();
     const T& back() const;
 
-    int size();
-    bool empty();
+    int size() const;
+    int capacity() const;
+    bool empty() const;
+    bool full() const;
+
+    Queue<T>& operator=(const Queue<T>& other);
+    Queue<T>& operator=(Queue<T>&& other);
+};
+
+// Queue that never grows on push: the capacity is set up front
+// (e.g. width*height for a BFS over a field) and overflow throws.
+template <typename T>
+class FixedQueue : public Queue<T> {
+public:
+    FixedQueue();
+    explicit FixedQueue(int capacity);
 };
 
+template <typename T>
+Queue<T>::Queue(int capacity, bool fixed) : m_fixed(fixed) {
+    reserve(capacity);
+}
+
+template <typename T>
+void Queue<T>::__copy(const Queue<T>& other) {
+    clear();
+    m_fixed = other.m_fixed;
+    reserve(other.m_capacity);
+    for (int i = 0; i < other.m_size; ++i)
+        push(other.m_arr[other.index(i)]);
+}
+
+template <typename T>
+void Queue<T>::__move(Queue<T>&& other) {
+    __free();
+    m_arr = other.m_arr;
+    m_capacity = other.m_capacity;
+    m_head = other.m_head;
+    m_size = other.m_size;
+    m_fixed = other.m_fixed;
+    other.m_arr = nullptr;
+    other.m_capacity = other.m_head = other.m_size = 0;
+}
+
+template <typename T>
+void Queue<T>::__free() {
+    clear();
+    ::operator delete(m_arr);
+    m_arr = nullptr;
+    m_capacity = 0;
+}
+
+template <typename T>
+void Queue<T>::__reserve_more() {
+    reserve(m_capacity == 0 ? initial_capacity : m_capacity * 2);
+}
+
+template <typename T>
+void Queue<T>::assume_not_empty() const {
+    if (empty())
+        throw std::out_of_range("Queue is empty");
+}
+
+template <typename T>
+void Queue<T>::assume_not_full() {
+    if (!full())
+        return;
+    if (m_fixed)
+        throw std::out_of_range("Queue is full");
+    __reserve_more();
+}
+
+template <typename T>
+int Queue<T>::index(int i) const {
+    i += m_head;
+    return i < m_capacity ? i : i - m_capacity;
+}
+
 template <typename T>
 Queue<T>::Queue() {}
 
+template <typename T>
+Queue<T>::Queue(int capacity) : Queue<T>(capacity, false) {}
+
+template <typename T>
+Queue<T>::Queue(const Queue<T>& other) {
+    __copy(other);
+}
+
+template <typename T>
+Queue<T>::Queue(Queue<T>&& other) {
+    __move(std::move(other));
+}
+
+template <typename T>
+Queue<T>::~Queue() {
+    __free();
+}
+
+template <typename T>
+void Queue<T>::reserve(int n) {
+    if (n <= m_capacity)
+        return;
+    T* new_arr = static_cast<T*>(::operator new(sizeof(T) * n));
+    for (int i = 0; i < m_size; ++i) {
+        T* old = m_arr + index(i);
+        new (new_arr + i) T(std::move(*old));
+        memory_utils::destruct(old);
+    }
+    ::operator delete(m_arr);
+    m_arr = new_arr;
+    m_capacity = n;
+    m_head = 0;
+}
+
+template <typename T>
+void Queue<T>::clear() {
+    while (m_size)
+        pop();
+    m_head = 0;
+}
+
 template <typename T>
 void Queue<T>::push(const T& t) {
-    m_list.add(t);
+    assume_not_full();
+    new (m_arr + index(m_size)) T(t);
+    ++m_size;
 }
 
 template <typename T>
 void Queue<T>::push(T&& t) {
-    m_list.add(std::move(t));
+    assume_not_full();
+    new (m_arr + index(m_size)) T(std::move(t));
+    ++m_size;
+}
+
+template <typename T>
+T Queue<T>::pop() {
+    assume_not_empty();
+    T* first = m_arr + m_head;
+    T t = std::move(*first);
+    memory_utils::destruct(first);
+    if (++m_head == m_capacity)
+        m_head = 0;
+    --m_size;
+    return t;
 }
 
 template <typename T>
 T& Queue<T>::front() {
-    return m_list.first();
+    assume_not_empty();
+    return m_arr[m_head];
 }
 
 template <typename T>
 const T& Queue<T>::front() const {
-    return m_list.first();
+    assume_not_empty();
+    return m_arr[m_head];
 }
 
 template <typename T>
 T& Queue<T>::back() {
-    return m_list.last();
+    assume_not_empty();
+    return m_arr[index(m_size - 1)];
 }
 
 template <typename T>
 const T& Queue<T>::back() const {
-    return m_list.last();
+    assume_not_empty();
+    return m_arr[index(m_size - 1)];
 }
 
 template <typename T>
-T Queue<T>::pop() {
-    T t = m_list.first();
-    m_list.remove_first();
-    return t;
+int Queue<T>::size() const {
+    return m_size;
 }
 
 template <typename T>
-int Queue<T>::size() {
-    return m_list.size();
+int Queue<T>::capacity() const {
+    return m_capacity;
 }
 
 template <typename T>
-bool Queue<T>::empty() {
-    return m_list.empty();
+bool Queue<T>::empty() const {
+    return m_size == 0;
 }
 
+template <typename T>
+bool Queue<T>::full() const {
+    return m_size == m_capacity;
+}
+
+template <typename T>
+Queue<T>& Queue<T>::operator=(const Queue<T>& other) {
+    if (this != &other) {
+        __copy(other);
+    }
+    return *this;
+}
+
+template <typename T>
+Queue<T>& Queue<T>::operator=(Queue<T>&& other) {
+    if (this != &other) {
+        __move(std::move(other));
+    }
+    return *this;
+}
+
+template <typename T>
+FixedQueue<T>::FixedQueue() : Queue<T>(0, true) {}
+
+template <typename T>
+FixedQueue<T>::FixedQueue(int capacity) : Queue<T>(capacity, true) {}
+
 #endif //CPP_MY_LIB_QUEUE_H
\ No newline at end of file
@@ -31,6 +31,9 @@ private:
 
     void __reserve_more(int n = 1);
 
+    template <typename... Args>
+    T& __grow_and_emplace(Args&&... args);
+
 protected:
 
     T* arr();
@@ -48,13 +51,21 @@ public:
 
     void resize(int n);
     void reserve(int n);
+    void shrink_to_fit();
     void clear();
 
+    template <typename... Args>
+    T& emplace(Args&&... args);
+
     void add(const T& elem);
     void add(T&& elem);
     void add(const Vector<T>& other);
     void add(Vector<T>&& other);
     void remove(int index);
+    void swap_remove(int index);
+
+    T* data();
+    const T* data() const;
 
     int size() const;
     int capacity() const;
@@ -94,13 +105,21 @@ public:
 
 template <typename T>
 void Vector<T>::__copy(const Vector<T>& other) {
-    resize(other.size());
-    for (int i = 0; i < m_size; ++i)
-        m_arr[i] = other.m_arr[i];
+    clear();
+    reserve(other.m_size);
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        if (other.m_size > 0)
+            std::memcpy(m_arr, other.m_arr, sizeof(T) * other.m_size);
+    } else {
+        for (int i = 0; i < other.m_size; ++i)
+            new (m_arr + i) T(other.m_arr[i]);
+    }
+    m_size = other.m_size;
 }
 
 template <typename T>
 void Vector<T>::__move(Vector<T>&& other) {
+    __free();
     m_size = other.m_size;
     m_capacity = other.m_capacity;
     m_arr = other.m_arr;
@@ -111,7 +130,8 @@ void Vector<T>::__move(Vector<T>&& other) {
 
 template <typename T>
 void Vector<T>::__free() {
-    delete[] m_arr;
+    memory_utils::destruct(m_arr, m_size);
+    memory_utils::deallocate(m_arr);
     m_arr = nullptr;
     m_size = m_capacity = 0;
 }
@@ -121,6 +141,26 @@ void Vector<T>::__reserve_more(int n) {
     reserve(m_capacity * 2 + n);
 }
 
+// The new element is constructed before the old ones are relocated,
+// so args may safely refer to elements of this vector.
+template <typename T>
+template <typename... Args>
+T& Vector<T>::__grow_and_emplace(Args&&... args) {
+    int new_capacity = m_capacity * 2 + 1;
+    T* new_arr = memory_utils::allocate<T>(new_capacity);
+    try {
+        new (new_arr + m_size) T(std::forward<Args>(args)...);
+    } catch (...) {
+        memory_utils::deallocate(new_arr);
+        throw;
+    }
+    memory_utils::relocate(new_arr, m_arr, m_size);
+    memory_utils::deallocate(m_arr);
+    m_arr = new_arr;
+    m_capacity = new_capacity;
+    return m_arr[m_size++];
+}
+
 template<typename T>
 T* Vector<T>::arr() {
     return m_arr;
@@ -163,72 +203,110 @@ template <typename T>
 void Vector<T>::resize(int n) {
     if (n > m_size) {
         reserve(n);
+        for (int i = m_size; i < n; ++i)
+            new (m_arr + i) T();
+        m_size = n;
+    } else if (n < m_size) {
+        memory_utils::destruct(m_arr + n, m_size - n);
         m_size = n;
     }
-    while (m_size > n)
-        remove(m_size - 1);
 }
 
 template <typename T>
 void Vector<T>::reserve(int n) {
     if (n > m_capacity) {
-        T* new_arr = new T[n];
-        for (int i = 0; i < m_size; ++i)
-            new_arr[i] = m_arr[i];
-        delete[] m_arr;
+        T* new_arr = memory_utils::allocate<T>(n);
+        memory_utils::relocate(new_arr, m_arr, m_size);
+        memory_utils::deallocate(m_arr);
         m_capacity = n;
         m_arr = new_arr;
     }
 }
 
+template <typename T>
+void Vector<T>::shrink_to_fit() {
+    if (m_size == m_capacity)
+        return;
+    T* new_arr = memory_utils::allocate<T>(m_size);
+    memory_utils::relocate(new_arr, m_arr, m_size);
+    memory_utils::deallocate(m_arr);
+    m_capacity = m_size;
+    m_arr = new_arr;
+}
+
 template <typename T>
 void Vector<T>::clear() {
     resize(0);
 }
 
+template <typename T>
+template <typename... Args>
+T& Vector<T>::emplace(Args&&... args) {
+    if (m_size == m_capacity)
+        return __grow_and_emplace(std::forward<Args>(args)...);
+    new (m_arr + m_size) T(std::forward<Args>(args)...);
+    return m_arr[m_size++];
+}
+
 template <typename T>
 void Vector<T>::add(const T& elem) {
-    if (m_size + 1 > m_capacity)
-        __reserve_more();
-    m_arr[m_size] = elem;
-    ++m_size;
+    emplace(elem);
 }
 
 template<typename T>
 void Vector<T>::add(T&& elem) {
-    if (m_size + 1 > m_capacity)
-        __reserve_more();
-    m_arr[m_size] = std::move(elem);
-    ++m_size;
+    emplace(std::move(elem));
 }
 
 template <typename T>
 void Vector<T>::add(const Vector<T>& other) {
-    int old_size = size();
-    resize(size() + other.size());
-    for (int i = old_size; i < size(); ++i)
-        operator[](i) = other[i-old_size];
+    if (this == &other) {
+        add(Vector<T>(other));
+        return;
+    }
+    reserve(m_size + other.m_size);
+    for (int i = 0; i < other.m_size; ++i)
+        new (m_arr + m_size + i) T(other.m_arr[i]);
+    m_size += other.m_size;
 }
 
 template <typename T>
 void Vector<T>::add(Vector<T>&& other) {
-    int old_size = size();
-    resize(size() + other.size());
-    for (int i = old_size; i < size(); ++i)
-        operator[](i) = std::move(other[i-old_size]);
-    other.__free();
+    reserve(m_size + other.m_size);
+    memory_utils::relocate(m_arr + m_size, other.m_arr, other.m_size);
+    m_size += other.m_size;
     other.m_size = 0;
-    other.m_capacity = 0;
+    other.__free();
 }
 
 template <typename T>
 void Vector<T>::remove(int index) {
-    memory_utils::destruct(m_arr + index);
     for (int i = index + 1; i < m_size; ++i)
-        m_arr[i - 1] = m_arr[i];
+        m_arr[i - 1] = std::move(m_arr[i]);
+    memory_utils::destruct(m_arr + m_size - 1);
+    --m_size;
+}
+
+// O(1) removal that moves the last element into the gap,
+// so the order of elements is not preserved.
+template <typename T>
+void Vector<T>::swap_remove(int index) {
+    if (index != m_size - 1)
+        m_arr[index] = std::move(m_arr[m_size - 1]);
+    memory_utils::destruct(m_arr + m_size - 1);
     --m_size;
 }
 
+template <typename T>
+T* Vector<T>::data() {
+    return m_arr;
+}
+
+template <typename T>
+const T* Vector<T>::data() const {
+    return m_arr;
+}
+
 template <typename T>
 int Vector<T>::size() const {
     return m_size;
@@ -246,10 +324,10 @@ bool Vector<T>::empty() const {
 
 template <typename T>
 Vector<T>& Vector<T>::operator=(const std::initializer_list<T>& initializerList) {
-    resize(initializerList.size());
-    auto iter = initializerList.begin();
-    for (int i = 0; i < m_size; ++i, ++iter)
-        m_arr[i] = *iter;
+    clear();
+    reserve(initializerList.size());
+    for (const T& elem : initializerList)
+        new (m_arr + m_size++) T(elem);
     return *this;
 }
 
@@ -0,0 +1,121 @@
+#ifndef CPP_MY_LIB_MPSC_QUEUE_H
+#define CPP_MY_LIB_MPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+// Bounded lock-free queue for many producers and one consumer, on a ring of
+// cells each carrying a sequence number (D. Vyukov's bounded queue).
+// Neither side allocates after construction; try_push fails when the ring is full.
+template <typename T>
+class MpscQueue {
+
+    struct cell {
+        std::atomic<std::size_t> m_sequence;
+        T m_value;
+    };
+
+    static constexpr std::size_t cache_line = 64;
+
+    cell* m_cells;
+    std::size_t m_mask;
+
+    alignas(cache_line) std::atomic<std::size_t> m_enqueue_pos = 0;
+    alignas(cache_line) std::atomic<std::size_t> m_dequeue_pos = 0; // written by the consumer only
+
+public:
+
+    // capacity must be a power of two
+    explicit MpscQueue(std::size_t capacity);
+
+    MpscQueue(const MpscQueue<T>&) = delete;
+    MpscQueue<T>& operator=(const MpscQueue<T>&) = delete;
+
+    ~MpscQueue();
+
+    std::size_t capacity() const;
+
+    // approximate while others push or pop
+    std::size_t size() const;
+
+    // any thread
+    bool try_push(const T& t);
+
+    // the consumer thread only
+    bool try_pop(T& t);
+    bool empty() const;
+};
+
+template <typename T>
+MpscQueue<T>::MpscQueue(std::size_t capacity) {
+    if (capacity < 2 || (capacity & (capacity - 1)) != 0)
+        throw std::invalid_argument("MpscQueue capacity must be a power of two");
+    m_cells = new cell[capacity];
+    m_mask = capacity - 1;
+    for (std::size_t i = 0; i < capacity; ++i)
+        m_cells[i].m_sequence.store(i, std::memory_order_relaxed);
+}
+
+template <typename T>
+MpscQueue<T>::~MpscQueue() {
+    delete[] m_cells;
+}
+
+template <typename T>
+std::size_t MpscQueue<T>::capacity() const {
+    return m_mask + 1;
+}
+
+template <typename T>
+std::size_t MpscQueue<T>::size() const {
+    std::size_t enqueued = m_enqueue_pos.load(std::memory_order_relaxed);
+    std::size_t dequeued = m_dequeue_pos.load(std::memory_order_relaxed);
+    return enqueued > dequeued ? enqueued - dequeued : 0;
+}
+
+template <typename T>
+bool MpscQueue<T>::try_push(const T& t) {
+    std::size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+    for (;;) {
+        cell& c = m_cells[pos & m_mask];
+        std::size_t seq = c.m_sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t diff = (std::ptrdiff_t) seq - (std::ptrdiff_t) pos;
+        if (diff == 0) {
+            // the cell is free for this lap, claim the position
+            if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                c.m_value = t;
+                c.m_sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false; // the consumer has not freed it yet: full
+        } else {
+            pos = m_enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <typename T>
+bool MpscQueue<T>::try_pop(T& t) {
+    std::size_t pos = m_dequeue_pos.load(std::memory_order_relaxed);
+    cell& c = m_cells[pos & m_mask];
+    std::size_t seq = c.m_sequence.load(std::memory_order_acquire);
+    if ((std::ptrdiff_t) seq - (std::ptrdiff_t) (pos + 1) < 0)
+        return false;
+    t = std::move(c.m_value);
+    c.m_sequence.store(pos + m_mask + 1, std::memory_order_release);
+    m_dequeue_pos.store(pos + 1, std::memory_order_relaxed);
+    return true;
+}
+
+template <typename T>
+bool MpscQueue<T>::empty() const {
+    std::size_t pos = m_dequeue_pos.load(std::memory_order_relaxed);
+    const cell& c = m_cells[pos & m_mask];
+    return (std::ptrdiff_t) c.m_sequence.load(std::memory_order_acquire) - (std::ptrdiff_t) (pos + 1) < 0;
+}
+
+#endif //CPP_MY_LIB_MPSC_QUEUE_H
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "ThreadPool.h"
+
+#include <utility>
+
+bool ThreadPool::try_get(int index, task& t) {
+    bool found = m_queues[index]->pop(t);
+    for (int i = 1; !found && i < m_queues.size(); ++i)
+        found = m_queues[(index + i) % m_queues.size()]->steal(t);
+    if (found)
+        --m_queued;
+    return found;
+}
+
+void ThreadPool::work(int index) {
+    current_pool = this;
+    current_index = index;
+    task t;
+    while (true) {
+        if (try_get(index, t)) {
+            try {
+                t();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock (m_mutex);
+                if (m_error == nullptr)
+                    m_error = std::current_exception();
+            }
+            t = nullptr;
+            if (--m_pending == 0) {
+                std::lock_guard<std::mutex> lock (m_mutex);
+                m_all_done.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> lock (m_mutex);
+        m_work_available.wait(lock, [this]() { return m_stopping || m_queued > 0; });
+        if (m_stopping && m_queued == 0)
+            return;
+        // m_queued is bumped before the push, so the task may not be visible yet
+        lock.unlock();
+        std::this_thread::yield();
+    }
+}
+
+ThreadPool::ThreadPool(int threads) {
+    if (threads <= 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 0; i < threads; ++i)
+        m_queues.add(std::make_unique<WorkStealingQueue<task>>());
+    for (int i = 0; i < threads; ++i)
+        m_threads.add(std::thread(&ThreadPool::work, this, i));
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        // an error nobody waited for is dropped, destructors must not throw
+        std::unique_lock<std::mutex> lock (m_mutex);
+        m_all_done.wait(lock, [this]() { return m_pending == 0; });
+        m_stopping = true;
+    }
+    m_work_available.notify_all();
+    for (std::thread& thread : m_threads)
+        thread.join();
+}
+
+int ThreadPool::size() const {
+    return m_queues.size();
+}
+
+void ThreadPool::submit(task t) {
+    int index = current_pool == this ? current_index : m_next_queue++ % m_queues.size();
+    ++m_pending;
+    ++m_queued;
+    m_queues[index]->push(std::move(t));
+    std::lock_guard<std::mutex> lock (m_mutex);
+    m_work_available.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock (m_mutex);
+    m_all_done.wait(lock, [this]() { return m_pending == 0; });
+    if (m_error != nullptr)
+        std::rethrow_exception(std::exchange(m_error, nullptr));
+}
\ No newline at end of file
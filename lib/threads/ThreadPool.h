@@ -0,0 +1,65 @@
+#ifndef CPP_MY_LIB_THREAD_POOL_H
+#define CPP_MY_LIB_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "../containers/vector/Vector.h"
+#include "WorkStealingQueue.h"
+
+// Fixed set of workers, each with its own WorkStealingQueue.
+// submit() from a worker goes to that worker's queue, from outside
+// the tasks are spread round-robin; idle workers steal from the others.
+class ThreadPool {
+
+public:
+
+    using task = std::function<void()>;
+
+private:
+
+    Vector<std::unique_ptr<WorkStealingQueue<task>>> m_queues;
+    Vector<std::thread> m_threads;
+
+    std::atomic<int> m_pending = 0; // submitted and not finished
+    std::atomic<int> m_queued = 0;  // submitted and not taken by a worker
+    std::atomic<int> m_next_queue = 0;
+    std::atomic<bool> m_stopping = false;
+
+    std::mutex m_mutex;
+    std::condition_variable m_work_available;
+    std::condition_variable m_all_done;
+
+    std::exception_ptr m_error; // the first one a task threw, guarded by m_mutex
+
+    inline static thread_local ThreadPool* current_pool = nullptr;
+    inline static thread_local int current_index = -1;
+
+    bool try_get(int index, task& t);
+    void work(int index);
+
+public:
+
+    // 0 threads means std::thread::hardware_concurrency()
+    explicit ThreadPool(int threads = 0);
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool();
+
+    int size() const;
+
+    void submit(task t);
+
+    // blocks until every submitted task has finished, then rethrows
+    // the first exception a task let out since the last wait()
+    void wait();
+};
+
+#endif //CPP_MY_LIB_THREAD_POOL_H
\ No newline at end of file
@@ -0,0 +1,61 @@
+#ifndef CPP_MY_LIB_TRIPLE_BUFFER_H
+#define CPP_MY_LIB_TRIPLE_BUFFER_H
+
+#include <atomic>
+
+// Lock-free single producer / single consumer hand-off of the latest value.
+// The writer fills write_buffer() and publish()es it, the reader calls update()
+// and then looks at read_buffer(); neither ever waits for the other.
+// Values published between two update() calls are skipped, only the last one is seen.
+template <typename T>
+class TripleBuffer {
+
+    static constexpr unsigned char index_mask = 3;
+    static constexpr unsigned char fresh_bit = 4;
+
+    T m_buffers[3];
+
+    int m_write = 0; // owned by the writer
+    std::atomic<unsigned char> m_middle = 1; // index of the spare buffer | fresh_bit if it was published
+    int m_read = 2;  // owned by the reader
+
+public:
+
+    TripleBuffer() = default;
+
+    TripleBuffer(const TripleBuffer<T>&) = delete;
+    TripleBuffer<T>& operator=(const TripleBuffer<T>&) = delete;
+
+    // the buffer the writer may fill; holds whatever value was there before
+    T& write_buffer();
+    void publish();
+
+    // true if a newer value was published since the last call
+    bool update();
+    const T& read_buffer() const;
+};
+
+template <typename T>
+T& TripleBuffer<T>::write_buffer() {
+    return m_buffers[m_write];
+}
+
+template <typename T>
+void TripleBuffer<T>::publish() {
+    m_write = m_middle.exchange(m_write | fresh_bit, std::memory_order_acq_rel) & index_mask;
+}
+
+template <typename T>
+bool TripleBuffer<T>::update() {
+    if (!(m_middle.load(std::memory_order_relaxed) & fresh_bit))
+        return false;
+    m_read = m_middle.exchange(m_read, std::memory_order_acq_rel) & index_mask;
+    return true;
+}
+
+template <typename T>
+const T& TripleBuffer<T>::read_buffer() const {
+    return m_buffers[m_read];
+}
+
+#endif //CPP_MY_LIB_TRIPLE_BUFFER_H
\ No newline at end of file
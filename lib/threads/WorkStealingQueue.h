@@ -0,0 +1,60 @@
+#ifndef CPP_MY_LIB_WORK_STEALING_QUEUE_H
+#define CPP_MY_LIB_WORK_STEALING_QUEUE_H
+
+#include <deque>
+#include <mutex>
+#include <utility>
+
+// Per-worker task deque: the owner pushes and pops at the back (LIFO, so it
+// keeps working on what is hot in its cache), other workers steal from the front.
+// Tasks are coarse (a whole game each), so a short per-queue lock is cheaper
+// than it looks and the queues of different workers never contend with each other.
+template <typename T>
+class WorkStealingQueue {
+
+    std::deque<T> m_tasks;
+    mutable std::mutex m_mutex;
+
+public:
+
+    void push(T t);
+
+    bool pop(T& t);
+    bool steal(T& t);
+
+    bool empty() const;
+};
+
+template <typename T>
+void WorkStealingQueue<T>::push(T t) {
+    std::lock_guard<std::mutex> lock (m_mutex);
+    m_tasks.push_back(std::move(t));
+}
+
+template <typename T>
+bool WorkStealingQueue<T>::pop(T& t) {
+    std::lock_guard<std::mutex> lock (m_mutex);
+    if (m_tasks.empty())
+        return false;
+    t = std::move(m_tasks.back());
+    m_tasks.pop_back();
+    return true;
+}
+
+template <typename T>
+bool WorkStealingQueue<T>::steal(T& t) {
+    std::lock_guard<std::mutex> lock (m_mutex);
+    if (m_tasks.empty())
+        return false;
+    t = std::move(m_tasks.front());
+    m_tasks.pop_front();
+    return true;
+}
+
+template <typename T>
+bool WorkStealingQueue<T>::empty() const {
+    std::lock_guard<std::mutex> lock (m_mutex);
+    return m_tasks.empty();
+}
+
+#endif //CPP_MY_LIB_WORK_STEALING_QUEUE_H
\ No newline at end of file
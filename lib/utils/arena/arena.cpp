@@ -0,0 +1,102 @@
+#include "arena.h"
+
+#include <new>
+
+arena::scope::scope(arena& a) : m_previous(s_current) {
+    s_current = &a;
+}
+
+arena::scope::~scope() {
+    s_current = m_previous;
+}
+
+arena::pool::~pool() {
+    for (char* block : m_blocks)
+        ::operator delete(block);
+}
+
+arena::arena() : m_pool(new pool) {}
+
+// Objects still alive keep their memory, e.g. an enemy a caller took out
+// of a field with remove_enemy(); the pool goes with the last of them.
+arena::~arena() {
+    if (m_pool->m_live == 0)
+        delete m_pool;
+    else
+        m_pool->m_orphaned = true;
+}
+
+void* arena::__bump(std::size_t bytes) {
+    pool& p = *m_pool;
+    if (p.m_cursor == nullptr || p.m_end - p.m_cursor < (std::ptrdiff_t) bytes) {
+        if (++p.m_block == p.m_blocks.size())
+            p.m_blocks.add(static_cast<char*>(::operator new(default_block_size)));
+        p.m_cursor = p.m_blocks[p.m_block];
+        p.m_end = p.m_cursor + default_block_size;
+    }
+    void* ptr = p.m_cursor;
+    p.m_cursor += bytes;
+    return ptr;
+}
+
+void* arena::__heap_allocate(std::size_t size) {
+    auto* h = static_cast<header*>(::operator new(header_size + size));
+    h->m_owner = nullptr;
+    h->m_size_class = 0;
+    return reinterpret_cast<char*>(h) + header_size;
+}
+
+void* arena::allocate(std::size_t size) {
+    std::size_t bytes = header_size + (size + alignment - 1) / alignment * alignment;
+    if (bytes > max_size)
+        return __heap_allocate(size);
+
+    pool& p = *m_pool;
+    std::size_t size_class = bytes / alignment - 1;
+    void* block;
+    if (p.m_free[size_class] != nullptr) {
+        block = p.m_free[size_class];
+        p.m_free[size_class] = p.m_free[size_class]->m_next;
+    } else {
+        block = __bump(bytes);
+    }
+
+    auto* h = static_cast<header*>(block);
+    h->m_owner = m_pool;
+    h->m_size_class = size_class;
+    ++p.m_live;
+    return static_cast<char*>(block) + header_size;
+}
+
+void arena::deallocate(void* ptr) {
+    if (ptr == nullptr)
+        return;
+    auto* h = reinterpret_cast<header*>(static_cast<char*>(ptr) - header_size);
+    pool* owner = h->m_owner;
+    if (owner == nullptr) {
+        ::operator delete(h);
+        return;
+    }
+    std::size_t size_class = h->m_size_class;
+    auto* node = reinterpret_cast<free_node*>(h);
+    node->m_next = owner->m_free[size_class];
+    owner->m_free[size_class] = node;
+    if (--owner->m_live == 0 && owner->m_orphaned)
+        delete owner;
+}
+
+void* arena::allocate_current(std::size_t size) {
+    return s_current != nullptr ? s_current->allocate(size) : __heap_allocate(size);
+}
+
+// Objects still alive would be handed out again, so the arena only rewinds
+// once all of them are gone; until then freed memory keeps going to the free lists.
+void arena::reset() {
+    pool& p = *m_pool;
+    if (p.m_live != 0)
+        return;
+    for (free_node*& head : p.m_free)
+        head = nullptr;
+    p.m_block = -1;
+    p.m_cursor = p.m_end = nullptr;
+}
\ No newline at end of file
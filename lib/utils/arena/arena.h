@@ -0,0 +1,107 @@
+#ifndef CPP_MY_LIB_ARENA_H
+#define CPP_MY_LIB_ARENA_H
+
+#include <cstddef>
+
+#include "../../containers/vector/Vector.h"
+
+// Bump allocator for many small objects of one owner (a level's entities).
+// Memory comes from large blocks handed out front to back; a freed object
+// goes to the free list of its size class and is reused before the cursor
+// moves on. Every object carries a header naming its arena, so it can be
+// deleted without knowing where it came from. reset() rewinds to the first
+// block in one go once nothing allocated from the arena is alive; the blocks
+// themselves are returned when the arena is destroyed, or, if objects from
+// it are still alive then, when the last of them is deleted.
+class arena {
+
+    static constexpr std::size_t size_class_count = 32;
+
+    struct free_node {
+        free_node* m_next;
+    };
+
+    // The state objects point back to, on the heap so that it can outlive the arena.
+    struct pool {
+        Vector<char*> m_blocks = Vector<char*>(0);
+        int m_block = -1;       // the block the cursor is in
+        char* m_cursor = nullptr;
+        char* m_end = nullptr;
+
+        free_node* m_free[size_class_count] {};
+
+        std::size_t m_live = 0;
+        bool m_orphaned = false;    // the arena is gone, the last deallocate frees the pool
+
+        ~pool();
+    };
+
+    struct header {
+        pool* m_owner;     // nullptr for objects that went to the heap
+        std::size_t m_size_class;
+    };
+
+    static constexpr std::size_t alignment = alignof(std::max_align_t);
+    static constexpr std::size_t header_size = (sizeof(header) + alignment - 1) / alignment * alignment;
+    static constexpr std::size_t max_size = size_class_count * alignment;
+
+    inline static thread_local arena* s_current = nullptr;
+
+    pool* m_pool;
+
+    void* __bump(std::size_t bytes);
+    static void* __heap_allocate(std::size_t size);
+
+public:
+
+    static constexpr std::size_t default_block_size = 16 * 1024;
+
+    // Makes an arena the one entity allocations go to on this thread
+    // for the lifetime of the scope; scopes nest.
+    class scope {
+
+        arena* m_previous;
+
+    public:
+
+        explicit scope(arena& a);
+
+        scope(const scope& other) = delete;
+        scope& operator=(const scope& other) = delete;
+
+        ~scope();
+    };
+
+    arena();
+
+    arena(const arena& other) = delete;
+    arena& operator=(const arena& other) = delete;
+
+    ~arena();
+
+    void* allocate(std::size_t size);
+    static void deallocate(void* ptr);
+
+    // from the current arena of this thread, from the heap when there is none
+    static void* allocate_current(std::size_t size);
+    static arena* current();
+
+    void reset();
+
+    std::size_t live() const;
+    std::size_t capacity() const;
+};
+
+inline arena* arena::current() {
+    return s_current;
+}
+
+inline std::size_t arena::live() const {
+    return m_pool->m_live;
+}
+
+inline std::size_t arena::capacity() const {
+    return m_pool->m_blocks.size() * default_block_size;
+}
+
+#endif //CPP_MY_LIB_ARENA_H
\ No newline at end of file
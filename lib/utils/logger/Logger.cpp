@@ -1,18 +1,41 @@
 #include "Logger.h"
 
 #include "Observable.h"
+#include "binary_log.h"
+#include "../sarialization/varint.h"
 
 Logger::Logger(Logger::LoggerBase* base) : m_base(base) {}
 
 Logger::Logger(std::shared_ptr<LoggerBase> base) : m_base(base) {}
 
-void Logger::update(const Observable& observable) {
-    m_base->update(observable);
+unsigned Logger::categories() const {
+    return m_categories;
+}
+
+void Logger::set_categories(unsigned categories) {
+    m_categories = categories;
+}
+
+log_level Logger::min_level() const {
+    return m_min_level;
+}
+
+void Logger::set_min_level(log_level level) {
+    m_min_level = level;
+}
+
+void Logger::update(const Observable& observable, log_category category, log_level level) {
+    if (accepts(category, level))
+        m_base->update(observable, category, level);
+}
+
+void Logger::tick(unsigned long long tick) {
+    m_base->tick(tick);
 }
 
 StreamLogger::StreamLoggerBase::StreamLoggerBase(const std::ostream& out) : m_out(out.rdbuf()) {}
 
-void StreamLogger::StreamLoggerBase::update(const Observable& observable) {
+void StreamLogger::StreamLoggerBase::update(const Observable& observable, log_category /*category*/, log_level /*level*/) {
     m_out << observable << std::endl;
 }
 
@@ -20,17 +43,184 @@ StreamLogger::StreamLogger(const std::ostream& out) : Logger(new StreamLoggerBas
 
 FileLogger::FileLoggerBase::FileLoggerBase(const char* filename) : m_out(filename) {}
 
-void FileLogger::FileLoggerBase::update(const Observable& observable) {
+void FileLogger::FileLoggerBase::update(const Observable& observable, log_category /*category*/, log_level /*level*/) {
     m_out << observable << std::endl;
 }
 
 FileLogger::FileLogger(const char* filename) : Logger(new FileLoggerBase(filename)) {}
 
+AsyncLogger::AsyncLoggerBase::AsyncLoggerBase(std::streambuf* out, std::size_t capacity, overflow_policy policy)
+: m_out(out), m_queue(capacity), m_policy(policy) {
+    m_writer = std::thread(&AsyncLoggerBase::write, this);
+}
+
+AsyncLogger::AsyncLoggerBase::AsyncLoggerBase(const char* filename, std::size_t capacity, overflow_policy policy)
+: m_file(filename), m_out(m_file.rdbuf()), m_queue(capacity), m_policy(policy) {
+    m_writer = std::thread(&AsyncLoggerBase::write, this);
+}
+
+AsyncLogger::AsyncLoggerBase::~AsyncLoggerBase() {
+    m_stopping = true;
+    wake_writer();
+    m_writer.join();
+}
+
+void AsyncLogger::AsyncLoggerBase::wake_writer() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_wake.notify_one();
+}
+
+void AsyncLogger::AsyncLoggerBase::update(const Observable& observable, log_category /*category*/, log_level /*level*/) {
+    log_record record = observable.record();
+    while (!m_queue.try_push(record)) {
+        if (m_policy == DROP) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        wake_writer();
+        std::this_thread::yield();
+    }
+    // a wake-up lost to the race with going idle only costs idle_wait of latency
+    if (m_writer_idle.load(std::memory_order_relaxed) && m_queue.size() >= m_queue.capacity() / 2)
+        wake_writer();
+}
+
+void AsyncLogger::AsyncLoggerBase::write() {
+    log_record record;
+    for (;;) {
+        bool written = false;
+        while (m_queue.try_pop(record)) {
+            m_out << record << '\n';
+            written = true;
+        }
+        if (written)
+            m_out.flush();
+
+        if (m_stopping) {
+            if (m_queue.empty())
+                break;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_writer_idle = true;
+        if (m_queue.empty() && !m_stopping)
+            m_wake.wait_for(lock, idle_wait);
+        m_writer_idle = false;
+    }
+    if (dropped() != 0)
+        m_out << "(" << dropped() << " log records dropped)" << std::endl;
+}
+
+unsigned long long AsyncLogger::AsyncLoggerBase::dropped() const {
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+AsyncLogger::AsyncLogger(const std::ostream& out, std::size_t capacity, overflow_policy policy)
+: Logger(new AsyncLoggerBase(out.rdbuf(), capacity, policy)) {}
+
+AsyncLogger::AsyncLogger(const char* filename, std::size_t capacity, overflow_policy policy)
+: Logger(new AsyncLoggerBase(filename, capacity, policy)) {}
+
+unsigned long long AsyncLogger::dropped() const {
+    return ((AsyncLoggerBase&) *m_base).dropped();
+}
+
+BinaryLogger::BinaryLoggerBase::BinaryLoggerBase(const char* filename) : m_out(filename, std::ios::binary) {
+    m_out.write(binary_log::magic, sizeof(binary_log::magic));
+    m_out.put((char) binary_log::version);
+}
+
+// Names are written once, the first time they are used.
+unsigned BinaryLogger::BinaryLoggerBase::name(const char* str) {
+    auto it = m_names.find(str);
+    if (it != m_names.end())
+        return it->second;
+    unsigned index = m_names.size();
+    m_names.emplace(str, index);
+    std::size_t length = std::char_traits<char>::length(str);
+    m_out.put((char) binary_log::NAME);
+    varint::write(m_out, index);
+    varint::write(m_out, length);
+    m_out.write(str, (std::streamsize) length);
+    return index;
+}
+
+void BinaryLogger::BinaryLoggerBase::write_field(const log_record::field& f) {
+    varint::write(m_out, name(f.m_name) << 1 | (f.m_pair ? 1 : 0));
+    varint::write(m_out, varint::zigzag(f.m_value[0]));
+    if (f.m_pair)
+        varint::write(m_out, varint::zigzag(f.m_value[1]));
+}
+
+void BinaryLogger::BinaryLoggerBase::update(const Observable& observable, log_category /*category*/, log_level /*level*/) {
+    log_record record = observable.record();
+
+    // fields that differ from the object's previous record; all of them for a new object
+    // or one whose layout changed, objects without an id are never diffed
+    log_record* last = nullptr;
+    if (record.m_id != 0) {
+        auto it = m_last.find(record.m_id);
+        if (it != m_last.end() && it->second.m_type == record.m_type && it->second.m_size == record.m_size)
+            last = &it->second;
+    }
+    int changed[log_record::max_fields];
+    int count = 0;
+    for (int i = 0; i < record.m_size; ++i) {
+        const log_record::field& f = record.m_fields[i];
+        if (last != nullptr) {
+            const log_record::field& g = last->m_fields[i];
+            if (f.m_name == g.m_name && f.m_pair == g.m_pair
+                    && f.m_value[0] == g.m_value[0] && f.m_value[1] == g.m_value[1])
+                continue;
+        }
+        changed[count++] = i;
+    }
+    if (last != nullptr && count == 0)
+        return;
+
+    // names first: a NAME must not split an event
+    unsigned type = name(record.m_type);
+    for (int i = 0; i < count; ++i)
+        name(record.m_fields[changed[i]].m_name);
+
+    if (!m_tick_written) {
+        m_out.put((char) binary_log::TICK);
+        varint::write(m_out, m_tick);
+        m_tick_written = true;
+    }
+
+    m_out.put((char) (last == nullptr ? binary_log::SPAWN : binary_log::UPDATE));
+    varint::write(m_out, record.m_id);
+    varint::write(m_out, type);
+    varint::write(m_out, count);
+    for (int i = 0; i < count; ++i)
+        write_field(record.m_fields[changed[i]]);
+
+    if (record.m_id != 0)
+        m_last[record.m_id] = record;
+}
+
+// Written lazily, ticks without events take no space.
+void BinaryLogger::BinaryLoggerBase::tick(unsigned long long tick) {
+    if (tick != m_tick) {
+        m_tick = tick;
+        m_tick_written = false;
+    }
+}
+
+BinaryLogger::BinaryLogger(const char* filename) : Logger(new BinaryLoggerBase(filename)) {}
+
 LoggerPool::LoggerPoolBase::LoggerPoolBase(const Vector<std::shared_ptr<Logger>>& loggers) : m_loggers(loggers) {}
 
-void LoggerPool::LoggerPoolBase::update(const Observable& observable) {
+void LoggerPool::LoggerPoolBase::update(const Observable& observable, log_category category, log_level level) {
+    for (auto logger : m_loggers)
+        logger->update(observable, category, level);
+}
+
+void LoggerPool::LoggerPoolBase::tick(unsigned long long tick) {
     for (auto logger : m_loggers)
-        logger->update(observable);
+        logger->tick(tick);
 }
 
 LoggerPool::LoggerPool(const Vector<std::shared_ptr<Logger>>& loggers) : Logger(new LoggerPoolBase(loggers)) {}
@@ -1,11 +1,20 @@
 #ifndef GAME_LOGGER_H
 #define GAME_LOGGER_H
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <iostream>
 #include <fstream>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 #include "../../containers/vector/Vector.h"
+#include "../../threads/MpscQueue.h"
+#include "log_record.h"
+#include "log_filter.h"
 
 class Observable; // pre-declaration
 
@@ -14,11 +23,16 @@ protected:
 
     class LoggerBase {
     public:
-        virtual void update(const Observable& observable) = 0;
+        virtual ~LoggerBase() = default;
+        virtual void update(const Observable& observable, log_category category, log_level level) = 0;
+        virtual void tick(unsigned long long /*tick*/) {}
     };
 
     std::shared_ptr<LoggerBase> m_base;
 
+    unsigned m_categories = log_filter::all_categories;
+    log_level m_min_level = log_level::DEBUG;
+
     Logger(LoggerBase* base);
     Logger(std::shared_ptr<LoggerBase> base);
 
@@ -26,7 +40,19 @@ public:
 
     virtual ~Logger() = default;
 
-    void update(const Observable& observable);
+    // run-time filter, on top of the compile-time one (see log_filter.h)
+    bool accepts(log_category category, log_level level) const;
+
+    unsigned categories() const;
+    void set_categories(unsigned categories);
+
+    log_level min_level() const;
+    void set_min_level(log_level level);
+
+    void update(const Observable& observable, log_category category, log_level level);
+
+    // called by the observed side when a new turn starts
+    void tick(unsigned long long tick);
 };
 
 class StreamLogger : public Logger {
@@ -38,7 +64,7 @@ protected:
 
         StreamLoggerBase(const std::ostream& out);
 
-        void update(const Observable& observable) override;
+        void update(const Observable& observable, log_category category, log_level level) override;
     };
 
 public:
@@ -55,7 +81,7 @@ protected:
 
         FileLoggerBase(const char* filename);
 
-        void update(const Observable& observable) override;
+        void update(const Observable& observable, log_category category, log_level level) override;
     };
 
 public:
@@ -63,6 +89,92 @@ public:
     FileLogger(const char* filename);
 };
 
+// Formats and writes on a background thread. update() only copies a log_record
+// into a bounded MpscQueue, so any number of threads may log without locking or
+// waiting on I/O; lines are written in batches and flushed when the queue runs dry.
+// Records still queued are written when the logger is destroyed.
+class AsyncLogger : public Logger {
+public:
+
+    enum overflow_policy {
+        DROP,  // a full queue loses the record (counted, reported at shutdown)
+        BLOCK  // a full queue makes the producer wait for the writer
+    };
+
+    inline static const std::size_t default_capacity = 1 << 14;
+
+protected:
+
+    class AsyncLoggerBase : public LoggerBase {
+
+        // the writer wakes up by itself this often, producers only wake it when the queue gets half full
+        inline static const auto idle_wait = std::chrono::milliseconds(5);
+
+        std::ofstream m_file;
+        std::ostream m_out;
+
+        MpscQueue<log_record> m_queue;
+        overflow_policy m_policy;
+        std::atomic<unsigned long long> m_dropped = 0;
+
+        std::atomic<bool> m_stopping = false;
+        std::atomic<bool> m_writer_idle = false;
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::thread m_writer;
+
+        void wake_writer();
+        void write();
+
+    public:
+        AsyncLoggerBase(std::streambuf* out, std::size_t capacity, overflow_policy policy);
+        AsyncLoggerBase(const char* filename, std::size_t capacity, overflow_policy policy);
+        ~AsyncLoggerBase() override;
+
+        void update(const Observable& observable, log_category category, log_level level) override;
+
+        unsigned long long dropped() const;
+    };
+
+public:
+
+    AsyncLogger(const std::ostream& out, std::size_t capacity = default_capacity, overflow_policy policy = DROP);
+    AsyncLogger(const char* filename, std::size_t capacity = default_capacity, overflow_policy policy = DROP);
+
+    unsigned long long dropped() const;
+};
+
+// Compact binary log (see binary_log.h): every record is diffed against the previous
+// one of the same object and only changed fields are written, tagged with the tick.
+// Decoded offline by tools/log_decoder.
+class BinaryLogger : public Logger {
+protected:
+
+    class BinaryLoggerBase : public LoggerBase {
+
+        std::ofstream m_out;
+
+        std::unordered_map<const char*, unsigned> m_names; // string literal -> index in the log
+        std::unordered_map<std::uint32_t, log_record> m_last; // by object id
+
+        unsigned long long m_tick = 0;
+        bool m_tick_written = true;
+
+        unsigned name(const char* str);
+        void write_field(const log_record::field& f);
+
+    public:
+        BinaryLoggerBase(const char* filename);
+
+        void update(const Observable& observable, log_category category, log_level level) override;
+        void tick(unsigned long long tick) override;
+    };
+
+public:
+
+    BinaryLogger(const char* filename);
+};
+
 class LoggerPool : public Logger {
 protected:
 
@@ -72,7 +184,8 @@ protected:
 
         LoggerPoolBase(const Vector<std::shared_ptr<Logger>>& loggers);
 
-        void update(const Observable& observable) override;
+        void update(const Observable& observable, log_category category, log_level level) override;
+        void tick(unsigned long long tick) override;
     };
 
 public:
@@ -86,4 +199,8 @@ public:
     void removeLogger(int index);
 };
 
+inline bool Logger::accepts(log_category category, log_level level) const {
+    return (m_categories & (unsigned) category) != 0 && level >= m_min_level;
+}
+
 #endif //GAME_LOGGER_H
\ No newline at end of file
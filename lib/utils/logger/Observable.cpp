@@ -1,8 +1,9 @@
 #include "Observable.h"
 
-void Observable::notify() const {
-    if (m_logger != nullptr)
-        m_logger->update(*this);
+log_record Observable::record() const {
+    log_record rec;
+    fill_record(rec);
+    return rec;
 }
 
 std::shared_ptr<Logger>& Observable::getLogger() {
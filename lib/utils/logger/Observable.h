@@ -5,6 +5,7 @@
 #include <memory>
 
 #include "Logger.h"
+#include "log_record.h"
 
 class Observable {
 
@@ -14,12 +15,19 @@ protected:
 
     virtual void print(std::ostream& out) const = 0;
 
+    // the same as print, for loggers that format later
+    virtual void fill_record(log_record& record) const = 0;
+
+    // compiles to nothing when the category or level is filtered out at compile time
+    template <log_category category, log_level level = log_level::INFO>
     void notify() const;
 
 public:
 
     virtual ~Observable() = default;
 
+    log_record record() const;
+
     std::shared_ptr<Logger>& getLogger();
     const std::shared_ptr<Logger>& getLogger() const;
 
@@ -32,4 +40,12 @@ public:
     friend std::ostream& operator<<(std::ostream& out, const Observable& observable);
 };
 
+template <log_category category, log_level level>
+void Observable::notify() const {
+    if constexpr (log_filter::compiled(category, level)) {
+        if (m_logger != nullptr)
+            m_logger->update(*this, category, level);
+    }
+}
+
 #endif //GAME_OBSERVABLE_H
\ No newline at end of file
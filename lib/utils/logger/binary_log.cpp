@@ -0,0 +1,81 @@
+#include "binary_log.h"
+
+#include <algorithm>
+
+#include "../sarialization/varint.h"
+
+namespace binary_log {
+
+    reader::reader(std::istream& in) : m_in(in) {
+        char header[sizeof(magic) + 1];
+        m_in.read(header, sizeof(header));
+        if (m_in.fail() || !std::equal(magic, magic + sizeof(magic), header) || (unsigned char) header[sizeof(magic)] != version)
+            throw std::runtime_error(BAD_HEADER_ERROR);
+    }
+
+    std::uint64_t reader::read_varint() {
+        std::uint64_t value;
+        if (!varint::read(m_in, value))
+            throw load_error{};
+        return value;
+    }
+
+    int reader::read_name() {
+        std::uint64_t index = read_varint();
+        if (index >= (std::uint64_t) m_names.size())
+            throw load_error{};
+        return (int) index;
+    }
+
+    bool reader::next(event& e) {
+        for (;;) {
+            int t = m_in.get();
+            if (t == std::char_traits<char>::eof())
+                return false;
+            switch (t) {
+                case TICK:
+                    m_tick = read_varint();
+                    break;
+                case NAME: {
+                    std::uint64_t index = read_varint();
+                    std::uint64_t length = read_varint();
+                    if (index != (std::uint64_t) m_names.size() || length > max_name_length)
+                        throw load_error{};
+                    std::string s (length, '\0');
+                    m_in.read(s.data(), (std::streamsize) length);
+                    if (m_in.fail())
+                        throw load_error{};
+                    m_names.add(std::move(s));
+                    break;
+                }
+                case SPAWN:
+                case UPDATE: {
+                    e.m_spawn = t == SPAWN;
+                    e.m_tick = m_tick;
+                    e.m_id = (std::uint32_t) read_varint();
+                    e.m_type = read_name();
+                    std::uint64_t count = read_varint();
+                    e.m_fields.clear();
+                    for (std::uint64_t i = 0; i < count; ++i) {
+                        std::uint64_t name = read_varint();
+                        if ((name >> 1) >= (std::uint64_t) m_names.size())
+                            throw load_error{};
+                        field f { (int) (name >> 1), { 0, 0 }, (bool) (name & 1) };
+                        f.m_value[0] = varint::unzigzag(read_varint());
+                        if (f.m_pair)
+                            f.m_value[1] = varint::unzigzag(read_varint());
+                        e.m_fields.add(f);
+                    }
+                    return true;
+                }
+                default:
+                    throw load_error{};
+            }
+        }
+    }
+
+    const std::string& reader::name(int index) const {
+        return m_names[index];
+    }
+
+}
\ No newline at end of file
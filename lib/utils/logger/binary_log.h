@@ -0,0 +1,73 @@
+#ifndef GAME_BINARY_LOG_H
+#define GAME_BINARY_LOG_H
+
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "../../containers/vector/Vector.h"
+#include "../sarialization/load_error.h"
+
+// Format written by BinaryLogger:
+//   header:  magic "GLOG", version byte
+//   events:  a tag byte followed by varints (signed values zigzagged)
+//     TICK    tick                                  the following events happened on that tick
+//     NAME    index, length, bytes                  defines a type or field name used later by index
+//     SPAWN   id, type, count, count x field        first record of an object: all fields
+//     UPDATE  id, type, count, count x field        only the fields changed since its last record
+//   field:   (name << 1 | is_pair), value [, second value]
+namespace binary_log {
+
+    inline constexpr char magic[4] = { 'G', 'L', 'O', 'G' };
+    inline constexpr unsigned char version = 1;
+
+    // names are type and field identifiers, a longer one means a corrupt log
+    inline constexpr std::uint64_t max_name_length = 1024;
+
+    enum tag : unsigned char {
+        TICK = 1,
+        NAME = 2,
+        SPAWN = 3,
+        UPDATE = 4
+    };
+
+    struct field {
+        int m_name; // index into reader::names()
+        long long m_value[2];
+        bool m_pair;
+    };
+
+    struct event {
+        bool m_spawn;
+        unsigned long long m_tick;
+        std::uint32_t m_id;
+        int m_type; // index into reader::names()
+        Vector<field> m_fields;
+    };
+
+    // Reads a log back event by event; throws load_error on a malformed one.
+    class reader {
+
+        inline static const char *const BAD_HEADER_ERROR = "Not a binary log or unsupported version.";
+
+        std::istream& m_in;
+        Vector<std::string> m_names;
+        unsigned long long m_tick = 0;
+
+        std::uint64_t read_varint();
+        int read_name();
+
+    public:
+
+        explicit reader(std::istream& in);
+
+        // false at the end of the log
+        bool next(event& e);
+
+        const std::string& name(int index) const;
+    };
+
+}
+
+#endif //GAME_BINARY_LOG_H
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include "log_filter.h"
+
+#include <cstring>
+
+namespace log_filter {
+
+    namespace {
+
+        struct category_name {
+            const char* m_name;
+            unsigned m_mask;
+        };
+
+        const category_name category_names[] = {
+                { "movement", (unsigned) log_category::MOVEMENT },
+                { "combat", (unsigned) log_category::COMBAT },
+                { "inventory", (unsigned) log_category::INVENTORY },
+                { "lifecycle", (unsigned) log_category::LIFECYCLE },
+                { "all", all_categories }
+        };
+
+        const char* const level_names[] = { "debug", "info", "warning" };
+
+    }
+
+    bool parse_categories(const char* str, unsigned& mask) {
+        unsigned result = 0;
+        while (*str != '\0') {
+            std::size_t length = std::strcspn(str, ",");
+            bool known = false;
+            for (const category_name& c : category_names) {
+                if (std::strlen(c.m_name) == length && std::strncmp(c.m_name, str, length) == 0) {
+                    result |= c.m_mask;
+                    known = true;
+                }
+            }
+            if (!known)
+                return false;
+            str += length;
+            if (*str == ',')
+                ++str;
+        }
+        mask = result;
+        return true;
+    }
+
+    bool parse_level(const char* str, log_level& level) {
+        for (int i = 0; i < (int) (sizeof(level_names) / sizeof(level_names[0])); ++i) {
+            if (std::strcmp(level_names[i], str) == 0) {
+                level = (log_level) i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+}
\ No newline at end of file
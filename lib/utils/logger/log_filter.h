@@ -0,0 +1,48 @@
+#ifndef GAME_LOG_FILTER_H
+#define GAME_LOG_FILTER_H
+
+// What a notification is about and how important it is. Both are filtered twice:
+// at compile time by GAME_LOG_CATEGORIES / GAME_LOG_MIN_LEVEL, where a disabled
+// notification compiles to nothing, and at run time by each Logger's own filter.
+
+#ifndef GAME_LOG_CATEGORIES
+#define GAME_LOG_CATEGORIES 0xF
+#endif
+
+#ifndef GAME_LOG_MIN_LEVEL
+#define GAME_LOG_MIN_LEVEL 0
+#endif
+
+enum class log_category : unsigned {
+    MOVEMENT  = 1,
+    COMBAT    = 2,
+    INVENTORY = 4,
+    LIFECYCLE = 8
+};
+
+enum class log_level : unsigned char {
+    DEBUG,
+    INFO,
+    WARNING
+};
+
+namespace log_filter {
+
+    inline constexpr unsigned all_categories = 0xF;
+
+    inline constexpr unsigned compiled_min_level = GAME_LOG_MIN_LEVEL;
+
+    constexpr bool compiled(log_category category, log_level level) {
+        return ((unsigned) GAME_LOG_CATEGORIES & (unsigned) category) != 0
+               && (unsigned) level >= compiled_min_level;
+    }
+
+    // comma separated names, e.g. "combat,lifecycle"; "all" for every category
+    bool parse_categories(const char* str, unsigned& mask);
+
+    // "debug", "info" or "warning"
+    bool parse_level(const char* str, log_level& level);
+
+}
+
+#endif //GAME_LOG_FILTER_H
\ No newline at end of file
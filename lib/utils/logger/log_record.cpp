@@ -0,0 +1,31 @@
+#include "log_record.h"
+
+void log_record::set_type(const char* type) {
+    m_type = type;
+}
+
+void log_record::add(const char* name, int value) {
+    if (m_size < max_fields)
+        m_fields[m_size++] = { name, { value, 0 }, false };
+}
+
+void log_record::add(const char* name, int first, int second) {
+    if (m_size < max_fields)
+        m_fields[m_size++] = { name, { first, second }, true };
+}
+
+std::ostream& operator<<(std::ostream& out, const log_record& record) {
+    out << record.m_type << "{ ";
+    for (int i = 0; i < record.m_size; ++i) {
+        const log_record::field& f = record.m_fields[i];
+        if (i != 0)
+            out << ", ";
+        out << f.m_name << '=';
+        if (f.m_pair)
+            out << "{ " << f.m_value[0] << ", " << f.m_value[1] << " }";
+        else
+            out << f.m_value[0];
+    }
+    out << " }";
+    return out;
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef GAME_LOG_RECORD_H
+#define GAME_LOG_RECORD_H
+
+#include <cstdint>
+#include <iostream>
+
+// Fixed-size copy of what an Observable would print: a type name and a few
+// named integer (or integer pair) fields. Names must be string literals, the
+// record is formatted later and possibly on another thread.
+struct log_record {
+
+    static constexpr int max_fields = 10;
+
+    struct field {
+        const char* m_name;
+        int m_value[2];
+        bool m_pair;
+    };
+
+    std::uint32_t m_id = 0; // identity of the source, 0 if it has none
+    const char* m_type = "";
+    int m_size = 0;
+    field m_fields[max_fields];
+
+    void set_type(const char* type);
+
+    // fields past max_fields are ignored
+    void add(const char* name, int value);
+    void add(const char* name, int first, int second);
+
+    friend std::ostream& operator<<(std::ostream& out, const log_record& record);
+};
+
+#endif //GAME_LOG_RECORD_H
\ No newline at end of file
@@ -1,10 +1,39 @@
 #ifndef CPP_MY_LIB_MEMORY_UTILS_H
 #define CPP_MY_LIB_MEMORY_UTILS_H
 
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Types whose objects may be moved to another address with a plain memcpy
+// (the source is then treated as gone, without calling its destructor).
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type {};
+
+template <typename T>
+struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type {};
+
 class memory_utils {
 public:
     template <typename T>
     static void destruct(T* ptr);
+
+    template <typename T>
+    static void destruct(T* first, int n);
+
+    template <typename T>
+    static T* allocate(int n);
+
+    template <typename T>
+    static void deallocate(T* ptr);
+
+    template <typename T>
+    static void relocate(T* dest, T* src, int n);
 };
 
 template <typename T>
@@ -13,4 +42,36 @@ void memory_utils::destruct(T* ptr) {
     ptr = nullptr;
 }
 
+template <typename T>
+void memory_utils::destruct(T* first, int n) {
+    if constexpr (!std::is_trivially_destructible_v<T>)
+        for (int i = 0; i < n; ++i)
+            first[i].~T();
+}
+
+// raw storage for n objects, nothing is constructed
+template <typename T>
+T* memory_utils::allocate(int n) {
+    return n > 0 ? static_cast<T*>(::operator new(sizeof(T) * n)) : nullptr;
+}
+
+template <typename T>
+void memory_utils::deallocate(T* ptr) {
+    ::operator delete(ptr);
+}
+
+// moves n objects from src into uninitialized dest, src is left uninitialized
+template <typename T>
+void memory_utils::relocate(T* dest, T* src, int n) {
+    if constexpr (is_trivially_relocatable<T>::value) {
+        if (n > 0)
+            std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src), sizeof(T) * n);
+    } else {
+        for (int i = 0; i < n; ++i) {
+            new (dest + i) T(std::move_if_noexcept(src[i]));
+            src[i].~T();
+        }
+    }
+}
+
 #endif //CPP_MY_LIB_MEMORY_UTILS_H
\ No newline at end of file
@@ -0,0 +1,119 @@
+#ifndef CPP_MY_LIB_PCG32_H
+#define CPP_MY_LIB_PCG32_H
+
+#include <cstdint>
+#include <iostream>
+
+#include "../sarialization/Savable.h"
+
+// PCG-XSH-RR 64/32 (O'Neill, pcg-random.org): 16 bytes of state, a multiply
+// and an add per number. Every owner gets its own engine, so there is no shared
+// state between fields and a seed fully determines the sequence.
+// Satisfies UniformRandomBitGenerator, so it also works with <random> distributions.
+class Pcg32 : public Savable {
+
+public:
+
+    using result_type = std::uint32_t;
+
+    static constexpr std::uint64_t default_seed = 0x853c49e6748fea9bULL;
+    static constexpr std::uint64_t default_stream = 0xda3e39cb94b95bdbULL;
+
+private:
+
+    static constexpr std::uint64_t multiplier = 6364136223846793005ULL;
+
+    std::uint64_t m_state = 0;
+    std::uint64_t m_inc = 0; // always odd
+
+public:
+
+    explicit Pcg32(std::uint64_t seed = default_seed, std::uint64_t stream = default_stream);
+
+    void seed(std::uint64_t seed, std::uint64_t stream = default_stream);
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+
+    result_type operator()();
+
+    // uniform in [0, bound), without modulo bias
+    result_type next(result_type bound);
+    bool next_bool();
+
+    bool operator==(const Pcg32& other) const;
+
+    void save(std::ostream& out) const override;
+    void load(std::istream& in) override;
+    void save(binary_writer& out) const override;
+    void load(binary_reader& in) override;
+};
+
+inline Pcg32::Pcg32(std::uint64_t seed, std::uint64_t stream) {
+    this->seed(seed, stream);
+}
+
+inline void Pcg32::seed(std::uint64_t seed, std::uint64_t stream) {
+    m_state = 0;
+    m_inc = (stream << 1) | 1;
+    operator()();
+    m_state += seed;
+    operator()();
+}
+
+inline Pcg32::result_type Pcg32::operator()() {
+    std::uint64_t old = m_state;
+    m_state = old * multiplier + m_inc;
+    auto xorshifted = (std::uint32_t) (((old >> 18) ^ old) >> 27);
+    auto rot = (std::uint32_t) (old >> 59);
+    return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+}
+
+inline Pcg32::result_type Pcg32::next(result_type bound) {
+    // Lemire's multiply-and-reject
+    std::uint64_t m = (std::uint64_t) operator()() * bound;
+    auto low = (std::uint32_t) m;
+    if (low < bound) {
+        std::uint32_t threshold = -bound % bound;
+        while (low < threshold) {
+            m = (std::uint64_t) operator()() * bound;
+            low = (std::uint32_t) m;
+        }
+    }
+    return m >> 32;
+}
+
+inline bool Pcg32::next_bool() {
+    return operator()() >> 31;
+}
+
+inline bool Pcg32::operator==(const Pcg32& other) const {
+    return m_state == other.m_state && m_inc == other.m_inc;
+}
+
+inline void Pcg32::save(std::ostream& out) const {
+    out << m_state << ' ' << m_inc << '\n';
+}
+
+inline void Pcg32::load(std::istream& in) {
+    in >> m_state;
+    if (in.fail())
+        throw load_error{};
+    in >> m_inc;
+    if (in.fail() || (m_inc & 1) == 0)
+        throw load_error{};
+}
+
+inline void Pcg32::save(binary_writer& out) const {
+    out.write<std::uint64_t>(m_state);
+    out.write<std::uint64_t>(m_inc);
+}
+
+inline void Pcg32::load(binary_reader& in) {
+    m_state = in.read<std::uint64_t>();
+    m_inc = in.read<std::uint64_t>();
+    if ((m_inc & 1) == 0)
+        throw load_error{};
+}
+
+#endif //CPP_MY_LIB_PCG32_H
\ No newline at end of file
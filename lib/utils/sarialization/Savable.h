@@ -4,12 +4,16 @@
 #include <iostream>
 
 #include "load_error.h"
+#include "binary_reader.h"
+#include "binary_writer.h"
 
 class Savable {
 public:
     virtual ~Savable() = default;
     virtual void save(std::ostream& out) const = 0;
     virtual void load(std::istream& in) = 0;
+    virtual void save(binary_writer& out) const = 0;
+    virtual void load(binary_reader& in) = 0;
 };
 
 #endif //GAME_SAVABLE_H
\ No newline at end of file
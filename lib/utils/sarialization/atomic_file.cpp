@@ -0,0 +1,117 @@
+#include "atomic_file.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+namespace atomic_file {
+
+#if defined(__unix__) || defined(__APPLE__)
+
+    static bool write_all(int fd, const char* data, std::size_t size) {
+        while (size > 0) {
+            ssize_t written = ::write(fd, data, size);
+            if (written < 0) {
+                if (errno == EINTR)
+                    continue;
+                return false;
+            }
+            data += written;
+            size -= written;
+        }
+        return true;
+    }
+
+    // the rename itself is only durable once the directory is flushed
+    void sync_directory(const char* filename) {
+        std::filesystem::path directory = std::filesystem::path(filename).parent_path();
+        int fd = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY);
+        if (fd < 0)
+            return;
+        fsync(fd);
+        ::close(fd);
+    }
+
+    bool prepare(const char* filename, const char* data, std::size_t size) {
+        std::string temporary = std::string(filename) + ".tmp";
+        int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+            return false;
+        bool ok = write_all(fd, data, size) && fsync(fd) == 0;
+        ok = ::close(fd) == 0 && ok;
+        if (!ok)
+            std::remove(temporary.c_str());
+        return ok;
+    }
+
+    bool commit(const char* filename, const char* tail, std::size_t tail_size) {
+        std::string temporary = std::string(filename) + ".tmp";
+        bool ok = true;
+        if (tail_size > 0) {
+            int fd = ::open(temporary.c_str(), O_WRONLY | O_APPEND);
+            ok = fd >= 0 && write_all(fd, tail, tail_size);
+            ok = fd >= 0 && ::close(fd) == 0 && ok;
+        }
+        if (!ok || std::rename(temporary.c_str(), filename) != 0) {
+            std::remove(temporary.c_str());
+            return false;
+        }
+        return true;
+    }
+
+#else
+
+    bool prepare(const char* filename, const char* data, std::size_t size) {
+        std::string temporary = std::string(filename) + ".tmp";
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        out.write(data, (std::streamsize) size);
+        out.flush();
+        if (!out) {
+            out.close();
+            std::remove(temporary.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    bool commit(const char* filename, const char* tail, std::size_t tail_size) {
+        std::string temporary = std::string(filename) + ".tmp";
+        if (tail_size > 0) {
+            std::ofstream out(temporary, std::ios::binary | std::ios::app);
+            out.write(tail, (std::streamsize) tail_size);
+            out.flush();
+            if (!out) {
+                out.close();
+                std::remove(temporary.c_str());
+                return false;
+            }
+        }
+        std::error_code error;
+        std::filesystem::rename(temporary, filename, error);
+        if (error) {
+            std::remove(temporary.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    void sync_directory(const char*) {}
+
+#endif
+
+    bool replace(const char* filename, const char* data, std::size_t size) {
+        if (!prepare(filename, data, size) || !commit(filename, nullptr, 0))
+            return false;
+        sync_directory(filename);
+        return true;
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#ifndef GAME_ATOMIC_FILE_H
+#define GAME_ATOMIC_FILE_H
+
+#include <cstddef>
+
+namespace atomic_file {
+
+    // Replaces the file with data so that a crash at any point leaves either
+    // the old or the new contents: written to filename.tmp, flushed to disk,
+    // then renamed over filename. false if any step fails.
+    bool replace(const char* filename, const char* data, std::size_t size);
+
+    // The steps of replace() one by one, for callers that hold a lock around
+    // the rename but not around the slow flush:
+    // prepare writes and flushes filename.tmp,
+    // commit appends tail (not flushed) to it and renames it over filename,
+    // sync_directory makes the rename durable.
+    bool prepare(const char* filename, const char* data, std::size_t size);
+    bool commit(const char* filename, const char* tail, std::size_t tail_size);
+    void sync_directory(const char* filename);
+
+}
+
+#endif //GAME_ATOMIC_FILE_H
\ No newline at end of file
@@ -0,0 +1,79 @@
+#ifndef GAME_BINARY_FILE_H
+#define GAME_BINARY_FILE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "binary_reader.h"
+#include "binary_writer.h"
+#include "crc32.h"
+
+// Framing for binary save files:
+//   char[4] magic, u32 version, u64 payload size, u32 CRC-32 of the payload,
+// then the payload. All integers little-endian.
+namespace binary_file {
+
+    inline constexpr std::size_t magic_size = 4;
+    inline constexpr std::size_t header_size = magic_size + 4 + 8 + 4;
+
+    // call before writing the payload, reserves room for the header
+    inline void begin(binary_writer& out) {
+        char header[header_size] = {};
+        out.write_bytes(header, header_size);
+    }
+
+    // call after the payload, fills in the header
+    inline void finish(binary_writer& out, const char* magic, std::uint32_t version) {
+        std::uint64_t payload_size = out.size() - header_size;
+        for (std::size_t i = 0; i < magic_size; ++i)
+            out.write_at<char>(i, magic[i]);
+        out.write_at<std::uint32_t>(magic_size, version);
+        out.write_at<std::uint64_t>(magic_size + 4, payload_size);
+        out.write_at<std::uint32_t>(magic_size + 12, crc32::compute(out.data() + header_size, payload_size));
+    }
+
+    // checks the header and the checksum, throws load_error on any mismatch;
+    // any version from oldest_version to newest_version is accepted and
+    // reported through version. The returned reader is positioned at the
+    // start of the payload
+    inline binary_reader open(const char* data, std::size_t size, const char* magic,
+                              std::uint32_t oldest_version, std::uint32_t newest_version, std::uint32_t& version) {
+        binary_reader in (data, size);
+        if (!std::equal(magic, magic + magic_size, in.read_bytes(magic_size)))
+            throw load_error{};
+        version = in.read<std::uint32_t>();
+        if (version < oldest_version || version > newest_version)
+            throw load_error{};
+        std::uint64_t payload_size = in.read<std::uint64_t>();
+        std::uint32_t checksum = in.read<std::uint32_t>();
+        if (payload_size != in.remaining())
+            throw load_error{};
+        if (crc32::compute(data + header_size, payload_size) != checksum)
+            throw load_error{};
+        return in;
+    }
+
+    inline binary_reader open(const char* data, std::size_t size, const char* magic, std::uint32_t version) {
+        std::uint32_t found;
+        return open(data, size, magic, version, version, found);
+    }
+
+    // the rest of the stream with a single read
+    inline std::string read_all(std::istream& in) {
+        in.seekg(0, std::ios::end);
+        std::streamoff end = in.tellg();
+        if (in.fail() || end < 0)
+            throw load_error{};
+        in.seekg(0, std::ios::beg);
+        std::string data (end, '\0');
+        in.read(data.data(), end);
+        if (in.fail())
+            throw load_error{};
+        return data;
+    }
+
+}
+
+#endif //GAME_BINARY_FILE_H
\ No newline at end of file
@@ -0,0 +1,73 @@
+#ifndef GAME_BINARY_READER_H
+#define GAME_BINARY_READER_H
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include "binary_writer.h"
+#include "load_error.h"
+
+// Reads what binary_writer wrote from a buffer it does not own.
+// Running past the end throws load_error.
+class binary_reader {
+    const char* m_position;
+    const char* m_end;
+
+    void __require(std::size_t size) const;
+
+public:
+    binary_reader(const char* data, std::size_t size);
+
+    template <typename T>
+    T read();
+
+    template <typename T>
+    void read(T* values, std::size_t count);
+
+    // the next size bytes, in place
+    const char* read_bytes(std::size_t size);
+
+    std::size_t remaining() const;
+};
+
+inline binary_reader::binary_reader(const char* data, std::size_t size) : m_position(data), m_end(data + size) {}
+
+inline void binary_reader::__require(std::size_t size) const {
+    if (size > (std::size_t) (m_end - m_position))
+        throw load_error{};
+}
+
+template <typename T>
+T binary_reader::read() {
+    __require(sizeof(T));
+    T value;
+    std::memcpy(&value, m_position, sizeof(T));
+    m_position += sizeof(T);
+    return binary_detail::to_little_endian(value);
+}
+
+template <typename T>
+void binary_reader::read(T* values, std::size_t count) {
+    if (count > remaining() / sizeof(T))
+        throw load_error{};
+    std::memcpy(values, m_position, count * sizeof(T));
+    m_position += count * sizeof(T);
+    if constexpr (std::endian::native != std::endian::little && sizeof(T) > 1) {
+        for (std::size_t i = 0; i < count; ++i)
+            values[i] = binary_detail::to_little_endian(values[i]);
+    }
+}
+
+inline const char* binary_reader::read_bytes(std::size_t size) {
+    __require(size);
+    const char* bytes = m_position;
+    m_position += size;
+    return bytes;
+}
+
+inline std::size_t binary_reader::remaining() const {
+    return m_end - m_position;
+}
+
+#endif //GAME_BINARY_READER_H
\ No newline at end of file
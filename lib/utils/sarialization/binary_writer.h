@@ -0,0 +1,105 @@
+#ifndef GAME_BINARY_WRITER_H
+#define GAME_BINARY_WRITER_H
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+// Fixed-width little-endian values appended to one in-memory buffer,
+// the caller writes the whole buffer out at once.
+class binary_writer {
+    std::string m_buffer;
+
+public:
+    binary_writer() = default;
+    explicit binary_writer(std::size_t capacity);
+
+    template <typename T>
+    void write(T value);
+
+    template <typename T>
+    void write(const T* values, std::size_t count);
+
+    void write_bytes(const void* data, std::size_t size);
+
+    // overwrites already written bytes, e.g. a header filled in at the end
+    template <typename T>
+    void write_at(std::size_t offset, T value);
+
+    void reserve(std::size_t capacity);
+    void clear();
+
+    const char* data() const;
+    std::size_t size() const;
+};
+
+namespace binary_detail {
+
+    template <typename T>
+    T to_little_endian(T value) {
+        static_assert(std::is_integral_v<T>, "only integers have a fixed binary layout");
+        if constexpr (std::endian::native == std::endian::little || sizeof(T) == 1) {
+            return value;
+        } else {
+            using U = std::make_unsigned_t<T>;
+            U u = (U) value, r = 0;
+            for (std::size_t i = 0; i < sizeof(T); ++i) {
+                r = (U) ((r << 8) | (u & 0xff));
+                u = (U) (u >> 8);
+            }
+            return (T) r;
+        }
+    }
+
+}
+
+inline binary_writer::binary_writer(std::size_t capacity) {
+    m_buffer.reserve(capacity);
+}
+
+template <typename T>
+void binary_writer::write(T value) {
+    value = binary_detail::to_little_endian(value);
+    m_buffer.append((const char*) &value, sizeof(T));
+}
+
+template <typename T>
+void binary_writer::write(const T* values, std::size_t count) {
+    if constexpr (std::endian::native == std::endian::little || sizeof(T) == 1) {
+        static_assert(std::is_integral_v<T>, "only integers have a fixed binary layout");
+        m_buffer.append((const char*) values, count * sizeof(T));
+    } else {
+        for (std::size_t i = 0; i < count; ++i)
+            write(values[i]);
+    }
+}
+
+inline void binary_writer::write_bytes(const void* data, std::size_t size) {
+    m_buffer.append((const char*) data, size);
+}
+
+template <typename T>
+void binary_writer::write_at(std::size_t offset, T value) {
+    value = binary_detail::to_little_endian(value);
+    std::memcpy(m_buffer.data() + offset, &value, sizeof(T));
+}
+
+inline void binary_writer::reserve(std::size_t capacity) {
+    m_buffer.reserve(capacity);
+}
+
+inline void binary_writer::clear() {
+    m_buffer.clear();
+}
+
+inline const char* binary_writer::data() const {
+    return m_buffer.data();
+}
+
+inline std::size_t binary_writer::size() const {
+    return m_buffer.size();
+}
+
+#endif //GAME_BINARY_WRITER_H
\ No newline at end of file
@@ -0,0 +1,37 @@
+#ifndef GAME_CRC32_H
+#define GAME_CRC32_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// CRC-32 (IEEE 802.3, reflected, polynomial 0xEDB88320), table driven.
+namespace crc32 {
+
+    inline constexpr std::array<std::uint32_t, 256> table = []() {
+        std::array<std::uint32_t, 256> t {};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t c = i;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+
+    // pass the previous result as crc to continue over several chunks
+    inline std::uint32_t update(std::uint32_t crc, const void* data, std::size_t size) {
+        const unsigned char* p = (const unsigned char*) data;
+        crc = ~crc;
+        for (std::size_t i = 0; i < size; ++i)
+            crc = table[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    inline std::uint32_t compute(const void* data, std::size_t size) {
+        return update(0, data, size);
+    }
+
+}
+
+#endif //GAME_CRC32_H
\ No newline at end of file
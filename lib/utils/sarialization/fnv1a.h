@@ -0,0 +1,27 @@
+#ifndef GAME_FNV1A_H
+#define GAME_FNV1A_H
+
+#include <cstddef>
+#include <cstdint>
+
+// 64-bit FNV-1a: a fast hash for comparing states, not a checksum for storage.
+namespace fnv1a {
+
+    inline constexpr std::uint64_t offset_basis = 0xcbf29ce484222325ull;
+    inline constexpr std::uint64_t prime = 0x100000001b3ull;
+
+    // pass the previous result as hash to continue over several chunks
+    inline std::uint64_t update(std::uint64_t hash, const void* data, std::size_t size) {
+        const unsigned char* p = (const unsigned char*) data;
+        for (std::size_t i = 0; i < size; ++i)
+            hash = (hash ^ p[i]) * prime;
+        return hash;
+    }
+
+    inline std::uint64_t compute(const void* data, std::size_t size) {
+        return update(offset_basis, data, size);
+    }
+
+}
+
+#endif //GAME_FNV1A_H
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "mapped_file.h"
+
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+mapped_file::mapped_file(mapped_file&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)) {
+#if !(defined(__unix__) || defined(__APPLE__))
+    m_buffer = std::move(other.m_buffer);
+    m_data = m_buffer.data();
+#endif
+}
+
+mapped_file::~mapped_file() {
+    __unmap();
+}
+
+mapped_file& mapped_file::operator=(mapped_file&& other) noexcept {
+    if (this != &other) {
+        __unmap();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+#if !(defined(__unix__) || defined(__APPLE__))
+        m_buffer = std::move(other.m_buffer);
+        m_data = m_buffer.data();
+#endif
+    }
+    return *this;
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+void mapped_file::__unmap() {
+    // an empty file is open but has nothing mapped
+    if (m_data != nullptr && m_size != 0)
+        munmap((void*) m_data, m_size);
+    m_data = nullptr;
+    m_size = 0;
+}
+
+bool mapped_file::open(const char* filename) {
+    close();
+    int fd = ::open(filename, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    m_size = (std::size_t) st.st_size;
+    if (m_size == 0) {
+        ::close(fd);
+        m_data = "";
+        return true;
+    }
+    void* p = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        m_size = 0;
+        return false;
+    }
+    m_data = (const char*) p;
+    return true;
+}
+
+#else
+
+void mapped_file::__unmap() {
+    m_buffer.clear();
+    m_data = nullptr;
+    m_size = 0;
+}
+
+bool mapped_file::open(const char* filename) {
+    close();
+    std::ifstream in(filename, std::ios::binary);
+    if (!in)
+        return false;
+    m_buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+    return true;
+}
+
+#endif
+
+void mapped_file::close() {
+    __unmap();
+}
+
+bool mapped_file::is_open() const {
+    return m_data != nullptr;
+}
+
+const char* mapped_file::data() const {
+    return m_data;
+}
+
+std::size_t mapped_file::size() const {
+    return m_size;
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef GAME_MAPPED_FILE_H
+#define GAME_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+// A whole file mapped read-only into memory. Pages are read from disk
+// when first touched, nothing is copied up front. Where mmap is not
+// available the file is read into a buffer instead.
+class mapped_file {
+    const char* m_data = nullptr;
+    std::size_t m_size = 0;
+#if !(defined(__unix__) || defined(__APPLE__))
+    std::string m_buffer;
+#endif
+
+    void __unmap();
+
+public:
+    mapped_file() = default;
+    mapped_file(const mapped_file& other) = delete;
+    mapped_file(mapped_file&& other) noexcept;
+    ~mapped_file();
+
+    mapped_file& operator=(const mapped_file& other) = delete;
+    mapped_file& operator=(mapped_file&& other) noexcept;
+
+    // false if the file cannot be opened or mapped
+    bool open(const char* filename);
+    void close();
+
+    bool is_open() const;
+
+    const char* data() const;
+    std::size_t size() const;
+};
+
+#endif //GAME_MAPPED_FILE_H
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef GAME_VARINT_H
+#define GAME_VARINT_H
+
+#include <cstdint>
+#include <iostream>
+
+// LEB128 variable-length integers: 7 bits per byte, high bit set on all but the last.
+// Signed values go through zigzag so that small negatives stay short.
+namespace varint {
+
+    inline void write(std::ostream& out, std::uint64_t value) {
+        while (value >= 0x80) {
+            out.put((char) (value | 0x80));
+            value >>= 7;
+        }
+        out.put((char) value);
+    }
+
+    // false on end of input or a value longer than 64 bits
+    inline bool read(std::istream& in, std::uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            int byte = in.get();
+            if (byte == std::char_traits<char>::eof())
+                return false;
+            value |= (std::uint64_t) (byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+                return true;
+        }
+        return false;
+    }
+
+    inline std::uint64_t zigzag(std::int64_t value) {
+        return ((std::uint64_t) value << 1) ^ (std::uint64_t) (value >> 63);
+    }
+
+    inline std::int64_t unzigzag(std::uint64_t value) {
+        return (std::int64_t) (value >> 1) ^ -(std::int64_t) (value & 1);
+    }
+
+}
+
+#endif //GAME_VARINT_H
\ No newline at end of file
@@ -1,3 +1,4 @@
+#include <ctime>
 #include <iostream>
 #include <getopt.h>
 
@@ -8,20 +9,39 @@
 #include "lib/containers/string/String.h"
 
 #include "prog/field/field.h"
+#include "prog/field/replay.h"
 #include "prog/adapters/sfml/sfml_adapter.h"
 
 int main(int argc, char** argv) {
 
-    std::srand(std::time(nullptr));
-
-    const char* short_options = "l::";
+    const char* short_options = "l::b:c:L:s:r::f:va:j:R:";
 
     const option long_options[] = {
             { "log", optional_argument, nullptr, 'l'},
+            { "binary-log", required_argument, nullptr, 'b'},
+            { "log-filter", required_argument, nullptr, 'c'},
+            { "log-level", required_argument, nullptr, 'L'},
+            { "seed", required_argument, nullptr, 's'},
+            { "real-time", optional_argument, nullptr, 'r'},
+            { "fps", required_argument, nullptr, 'f'},
+            { "vsync", no_argument, nullptr, 'v'},
+            { "autosave", required_argument, nullptr, 'a'},
+            { "journal", required_argument, nullptr, 'j'},
+            { "record", required_argument, nullptr, 'R'},
             {nullptr, 0, nullptr, 0 }
     };
 
     std::shared_ptr<Logger> logger;
+    unsigned log_categories = log_filter::all_categories;
+    log_level min_log_level = log_level::DEBUG;
+    std::uint64_t seed = std::time(nullptr);
+    bool real_time = false;
+    float tick_rate = 0;
+    int frame_limit = -1;
+    bool vsync = false;
+    int autosave_interval = 0;
+    const char* journal_filename = nullptr;
+    const char* record_filename = nullptr;
 
     int opchar;
     int option_index;
@@ -30,17 +50,76 @@ int main(int argc, char** argv) {
         switch (opchar) {
             case 'l':
                 if (optarg == nullptr)
-                    logger = std::shared_ptr<Logger>(new StreamLogger(std::cout));
+                    logger = std::shared_ptr<Logger>(new AsyncLogger(std::cout));
                 else
-                    logger = std::shared_ptr<Logger>(new FileLogger(optarg));
+                    logger = std::shared_ptr<Logger>(new AsyncLogger(optarg));
+                break;
+            case 'b':
+                logger = std::shared_ptr<Logger>(new BinaryLogger(optarg));
+                break;
+            case 'c':
+                if (!log_filter::parse_categories(optarg, log_categories)) {
+                    std::cerr << "unknown log category in: " << optarg << " (movement, combat, inventory, lifecycle, all)\n";
+                    return 1;
+                }
+                break;
+            case 'L':
+                if (!log_filter::parse_level(optarg, min_log_level)) {
+                    std::cerr << "unknown log level: " << optarg << " (debug, info, warning)\n";
+                    return 1;
+                }
+                break;
+            case 's':
+                seed = std::strtoull(optarg, nullptr, 10);
+                break;
+            case 'r':
+                real_time = true;
+                if (optarg != nullptr)
+                    tick_rate = std::atof(optarg);
+                break;
+            case 'f':
+                frame_limit = std::atoi(optarg);
+                break;
+            case 'v':
+                vsync = true;
+                break;
+            case 'a':
+                autosave_interval = std::atoi(optarg);
+                break;
+            case 'j':
+                journal_filename = optarg;
+                break;
+            case 'R':
+                record_filename = optarg;
                 break;
             default:
                 break;
         }
     }
 
-    sfml_adapter<5> adapter;
+    if (logger != nullptr) {
+        logger->set_categories(log_categories);
+        logger->set_min_level(min_log_level);
+    }
+
+    sfml_adapter<5> adapter (field_settings<5>{ seed });
     adapter.get_field()->set_logger(logger);
+    if (journal_filename != nullptr) {
+        // resume where the last session stopped, if its journal is usable
+        try {
+            adapter.get_field()->recover(journal_filename);
+        } catch (load_error&) {}
+        adapter.get_field()->set_journal(std::make_shared<turn_journal>(journal_filename));
+    }
+    if (record_filename != nullptr)
+        adapter.get_field()->set_recorder(std::make_shared<replay::recorder>(record_filename, *adapter.get_field(), 5, seed));
+    adapter.set_real_time(real_time);
+    if (tick_rate > 0)
+        adapter.set_tick_rate(tick_rate);
+    if (frame_limit >= 0)
+        adapter.set_frame_limit(frame_limit);
+    adapter.set_vsync(vsync);
+    adapter.set_autosave_interval(autosave_interval);
     adapter.start();
 
 //    character c;
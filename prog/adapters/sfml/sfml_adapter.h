@@ -1,19 +1,28 @@
 #ifndef GAME_SFML_ADAPTER_H
 #define GAME_SFML_ADAPTER_H
 
+#include <atomic>
 #include <memory>
+#include <thread>
 
 #include <SFML/System.hpp>
 #include <SFML/Window.hpp>
 #include <SFML/Graphics.hpp>
 
 #include "KeyBindings.h"
+#include "texture_atlas.h"
 
 #include "../../field/field.h"
+#include "../../field/field_snapshot.h"
+#include "../../field/save_service.h"
+#include "../../../lib/threads/TripleBuffer.h"
 #include "window/RenderWindow.h"
 #include "../../field/Game.h"
 #include "sfml_event_getter.h"
 
+// The calling thread runs the field and handles input, a render thread draws.
+// They only share the window (events stay on the calling thread, drawing on the
+// render one) and a TripleBuffer of field_snapshots: the field is never read while drawn.
 template <int field_id>
 class sfml_adapter {
 
@@ -29,16 +38,43 @@ private:
     inline static const float s_border_ratio = 0.05;
     inline static const sf::Color s_border_color = sf::Color( 17, 37, 26);
 
-    inline static sf::Texture wall {};
-    inline static sf::Texture grass {};
-    inline static sf::Texture player {};
-    inline static sf::Texture zombie {};
-    inline static sf::Texture skeleton {};
-    inline static sf::Texture trapdoor {};
-    inline static sf::Texture protein {};
-    inline static sf::Texture apple {};
-    inline static sf::Texture golden_apple {};
-    inline static sf::Texture knife {};
+    inline static const char* const images_directory = "../assets/images";
+
+    enum sprite {
+        WALL,
+        GRASS,
+        PLAYER,
+        ZOMBIE,
+        SKELETON,
+        TRAPDOOR,
+        PROTEIN,
+        APPLE,
+        GOLDEN_APPLE,
+        KNIFE,
+
+        SPRITE_COUNT
+    };
+
+    inline static const char* const sprite_images[SPRITE_COUNT] = {
+            "Wall.png",
+            "Grass.png",
+            "Player_with_hands2.png",
+            "Zombie_with_hands.png",
+            "Skeleton_with_hands.png",
+            "Trapdoor.png",
+            "Protein.png",
+            "Apple.png",
+            "Golden_Apple.png",
+            "Knife.png"
+    };
+
+    inline static const float health_bar_ratio = 0.05f;
+
+    inline static const float default_tick_rate = 4; // simulation steps per second in real-time mode
+    inline static const unsigned default_frame_limit = 60;
+    inline static const int max_ticks_per_frame = 5;
+    inline static const sf::Time max_input_latency = sf::milliseconds(10);
+    inline static const sf::Time idle_frame_time = sf::milliseconds(1); // render thread nap when unpaced and idle
 
     inline static const char* const window_name = "Game";
 
@@ -46,7 +82,8 @@ private:
             default_window_width = 900,
             default_window_height = 900;
 
-    int m_window_width, m_window_height;
+    // written on resize by the input thread, followed by the render thread
+    std::atomic<int> m_window_width, m_window_height;
 
     game_s_ptr m_game_p;
     field_s_ptr m_field_p;
@@ -54,26 +91,102 @@ private:
     RenderWindow* m_window;
     sfml_event_getter m_event_getter;
 
+    texture_atlas m_atlas;
+    sf::IntRect m_sprites[SPRITE_COUNT];
+
+    TripleBuffer<field_snapshot> m_snapshots;
+    unsigned long long m_sequence = 0;
+    unsigned long long m_ticks = 0;
+
+    std::thread m_render_thread;
+    std::atomic<bool> m_rendering = false;
+
+    // everything below up to the game loop settings belongs to the render thread while it runs
+
+    // the vertex storage is kept between rebuilds
+    sf::VertexArray m_terrain_layer { sf::Quads };
+    sf::VertexArray m_entity_layer { sf::Quads };
+    sf::VertexArray m_dirty_background { sf::Quads }; // tiles copied from m_static_frame
+    Bitset m_dirty_mask; // dirty cells of the snapshot being drawn, indexed like its m_cells
+
+    // layout of the field image, recomputed on resize and on level load
+    float m_border_width = 0;
+    float m_cell_width = 0, m_cell_height = 0;
+    int m_layout_width = -1, m_layout_height = -1;
+    int m_layout_generation = -1;
+
+    // kept across frames: m_static_frame holds border, terrain and exit and is
+    // re-rendered only when the layout or the terrain generation changes;
+    // m_frame is the last picture, only the snapshot's dirty cells are redrawn in it
+    sf::RenderTexture m_static_frame;
+    sf::RenderTexture m_frame;
+    int m_static_generation = -1;
+    bool m_frame_valid = false;
+
+    unsigned long long m_drawn_sequence = 0;
+    unsigned long long m_drawn_tick = 0;
+    sf::Clock m_tick_clock; // time since the drawn tick arrived
+    float m_drawn_alpha = 1;
+
+    // game loop: in real-time mode the field steps at m_tick_rate regardless of input,
+    // and frames in between draw characters interpolated from their previous cell
+    bool m_real_time = false;
+    float m_tick_rate = default_tick_rate;
+    unsigned m_frame_limit = default_frame_limit;
+    bool m_vsync = false;
+
+    field_snapshot::coords_map m_previous_coords;
+
+    // finishes the pending save when the adapter is destroyed
+    save_service m_saves;
+
     void load_images();
 
     void create_window();
+    void close_window();
     void delete_window();
+    void apply_video_settings();
+
+    void start_rendering();
+    void stop_rendering();
+    void render_loop();
+
+    void tick();
+    void publish();
 
     void handle_event(const sf::Event& event);
+    void handle_resize();
+
+    void update_layout(const field_snapshot& snap);
+    void render_static_layer(const field_snapshot& snap);
+    sf::FloatRect cell_rect(geo::i_point coords) const;
+    sf::FloatRect cell_rect(float x, float y) const;
+    sf::FloatRect entity_rect(const entity_snapshot& ent, float alpha) const;
 
     void clear();
-    void draw();
+    void draw(const field_snapshot& snap, bool fresh);
     void display();
-    void refresh();
 
     sf::Color health_color(float percentage);
 
+    void redraw_all(const field_snapshot& snap, float alpha);
+    void redraw_dirty(const field_snapshot& snap);
+
+    void append_entity(sf::VertexArray& layer, const entity_snapshot& ent, float alpha);
+    void append_sprite(sf::VertexArray& layer, sprite sp, sf::FloatRect dest);
+    void append_health_bar(sf::VertexArray& layer, const entity_snapshot& ch, sf::FloatRect dest);
+
 public:
 
     sfml_adapter(
             int window_width = default_window_width,
             int window_height = default_window_height);
 
+    explicit sfml_adapter(
+            field_settings<field_id> settings,
+            int window_width = default_window_width,
+            int window_height = default_window_height);
+
     ~sfml_adapter();
 
     game_s_ptr get_game();
@@ -83,24 +196,32 @@ public:
     field_s_ptr get_field();
     const field_s_ptr& get_field() const;
 
+    bool real_time() const;
+    void set_real_time(bool real_time);
+
+    float tick_rate() const;
+    void set_tick_rate(float ticks_per_second);
+
+    // 0 means no limit
+    unsigned frame_limit() const;
+    void set_frame_limit(unsigned frames_per_second);
+
+    // overrides the frame limit while enabled
+    bool vsync() const;
+    void set_vsync(bool vsync);
+
+    // saves in the background every so many turns, 0 turns it off
+    int autosave_interval() const;
+    void set_autosave_interval(int turns);
+
     void start();
 };
 
 template <int field_id>
 void sfml_adapter<field_id>::load_images() {
-    wall.loadFromFile("../assets/images/Wall.png");
-    grass.loadFromFile("../assets/images/Grass.png");
-//    player.loadFromFile("../assets/images/Player.png");
-//    zombie.loadFromFile("../assets/images/Zombie.png");
-//    skeleton.loadFromFile("../assets/images/Skeleton.png");
-    player.loadFromFile("../assets/images/Player_with_hands2.png");
-    zombie.loadFromFile("../assets/images/Zombie_with_hands.png");
-    skeleton.loadFromFile("../assets/images/Skeleton_with_hands.png");
-    trapdoor.loadFromFile("../assets/images/Trapdoor.png");
-    protein.loadFromFile("../assets/images/Protein.png");
-    apple.loadFromFile("../assets/images/Apple.png");
-    golden_apple.loadFromFile("../assets/images/Golden_Apple.png");
-    knife.loadFromFile("../assets/images/Knife.png");
+    m_atlas.load(images_directory);
+    for (int i = 0; i < SPRITE_COUNT; ++i)
+        m_sprites[i] = m_atlas.rect(sprite_images[i]);
 }
 
 template <int field_id>
@@ -108,25 +229,101 @@ void sfml_adapter<field_id>::create_window() {
     delete_window();
     m_window = new RenderWindow(m_window_width, m_window_height, window_name);
     m_event_getter.set_window(m_window);
+    apply_video_settings();
+    start_rendering();
+}
+
+template <int field_id>
+void sfml_adapter<field_id>::close_window() {
+    stop_rendering();
+    m_window->close();
+    m_saves.save(*m_field_p);
 }
 
 template <int field_id>
 void sfml_adapter<field_id>::delete_window() {
+    stop_rendering();
     delete m_window;
     m_window = nullptr;
 }
 
+// Only while the render thread is stopped: it changes how display() waits.
+template <int field_id>
+void sfml_adapter<field_id>::apply_video_settings() {
+    if (m_window == nullptr)
+        return;
+    m_window->setVerticalSyncEnabled(m_vsync);
+    m_window->setFramerateLimit(m_vsync ? 0 : m_frame_limit);
+}
+
+// The window's GL context can be active in one thread only, so it is handed over.
+template <int field_id>
+void sfml_adapter<field_id>::start_rendering() {
+    if (m_rendering)
+        return;
+    m_window->setActive(false);
+    m_frame_valid = false;
+    m_rendering = true;
+    m_render_thread = std::thread(&sfml_adapter<field_id>::render_loop, this);
+}
+
+template <int field_id>
+void sfml_adapter<field_id>::stop_rendering() {
+    if (!m_rendering)
+        return;
+    m_rendering = false;
+    m_render_thread.join();
+}
+
+template <int field_id>
+void sfml_adapter<field_id>::render_loop() {
+    m_window->setActive(true);
+    while (m_rendering) {
+        bool fresh = m_snapshots.update();
+        const field_snapshot& snap = m_snapshots.read_buffer();
+        if (snap.m_sequence == 0) {
+            sf::sleep(idle_frame_time); // nothing published yet
+            continue;
+        }
+        bool idle = !fresh && m_frame_valid && m_drawn_alpha >= 1
+                && m_layout_width == m_window_width && m_layout_height == m_window_height;
+        clear();
+        draw(snap, fresh);
+        display();
+        if (idle && !m_vsync && m_frame_limit == 0)
+            sf::sleep(idle_frame_time);
+    }
+    m_window->setActive(false);
+}
+
+// One fixed simulation step; remembers where the characters were for interpolation.
+template <int field_id>
+void sfml_adapter<field_id>::tick() {
+    m_previous_coords.clear();
+    m_previous_coords[&m_field_p->get_player()] = m_field_p->get_player().coords();
+    for (const enemy* en : m_field_p->get_enemies())
+        m_previous_coords[en] = en->coords();
+    m_field_p->send_sygnal(sygnal::STEP);
+    ++m_ticks;
+}
+
+template <int field_id>
+void sfml_adapter<field_id>::publish() {
+    field_snapshot& snap = m_snapshots.write_buffer();
+    snap.capture(*m_field_p, ++m_sequence, m_previous_coords);
+    snap.m_tick = m_ticks;
+    m_snapshots.publish();
+    m_saves.autosave(*m_field_p);
+}
+
 template <int field_id>
 void sfml_adapter<field_id>::handle_event(const sf::Event& event) {
     switch (event.type) {
         case sf::Event::Closed:
-            m_window->close();
-            m_field_p->save();
+            close_window();
             break;
         case sf::Event::Resized:
-            m_window_width = m_window->getSize().x;
-            m_window_height = m_window->getSize().y;
-            ((sf::View&) m_window->getView()).reset(sf::FloatRect(0, 0, m_window_width, m_window_height));
+            handle_resize();
             break;
         case sf::Event::LostFocus:
         case sf::Event::GainedFocus:
@@ -151,13 +348,17 @@ void sfml_adapter<field_id>::handle_event(const sf::Event& event) {
                     break;
                 case Key::RESTART:
                     m_field_p->send_sygnal(sygnal::RESTART);
+                    m_previous_coords.clear();
                     break;
                 case Key::FULLSCREEN:
+                    stop_rendering();
                     m_window->switchFullscreen();
+                    apply_video_settings();
+                    handle_resize();
+                    start_rendering();
                     break;
                 case Key::EXIT:
-                    m_window->close();
-                    m_field_p->save();
+                    close_window();
                     break;
                 default:
                     break;
@@ -186,164 +387,251 @@ void sfml_adapter<field_id>::handle_event(const sf::Event& event) {
     }
 }
 
+// The render thread notices the new size and lays the field out again.
 template <int field_id>
-void sfml_adapter<field_id>::clear() {
-    m_window->clear();
+void sfml_adapter<field_id>::handle_resize() {
+    m_window_width = m_window->getSize().x;
+    m_window_height = m_window->getSize().y;
 }
 
+// Fits the field into the window and (re)creates the render textures,
+// only when their size actually changes.
 template <int field_id>
-void sfml_adapter<field_id>::draw() {
+void sfml_adapter<field_id>::update_layout(const field_snapshot& snap) {
 
-    float border_width = std::min(m_window_width, m_window_height) * s_border_ratio;
+    int window_width = m_window_width, window_height = m_window_height;
+    if (window_width != m_layout_width || window_height != m_layout_height)
+        ((sf::View&) m_window->getView()).reset(sf::FloatRect(0, 0, window_width, window_height));
+
+    float border_width = std::min(window_width, window_height) * s_border_ratio;
     border_width = std::max((float) s_min_border_width, border_width);
     border_width = std::min((float) s_max_border_width, border_width);
 
-    float field_ratio = ((float) m_field_p->width()) / ((float) m_field_p->height());
-    float window_ratio = (m_window_width - 2*border_width) / (m_window_height - 2*border_width);
+    float field_ratio = ((float) snap.m_width) / ((float) snap.m_height);
+    float window_ratio = (window_width - 2*border_width) / (window_height - 2*border_width);
 
     float image_width, image_height;
 
     if (field_ratio < window_ratio) {
-        image_height = m_window_height - 2*border_width;
+        image_height = window_height - 2*border_width;
         image_width = image_height * field_ratio;
     } else if (field_ratio > window_ratio) {
-        image_width = m_window_width - 2*border_width;
+        image_width = window_width - 2*border_width;
         image_height = image_width / field_ratio;
     } else {
-        image_width = m_window_width - 2*border_width;
-        image_height = m_window_height - 2*border_width;
+        image_width = window_width - 2*border_width;
+        image_height = window_height - 2*border_width;
+    }
+
+    m_border_width = border_width;
+    m_cell_width = image_width / snap.m_width;
+    m_cell_height = image_height / snap.m_height;
+    m_layout_width = window_width;
+    m_layout_height = window_height;
+    m_layout_generation = snap.m_terrain_generation;
+
+    unsigned frame_width = image_width + 2*border_width;
+    unsigned frame_height = image_height + 2*border_width;
+    if (m_frame.getSize().x != frame_width || m_frame.getSize().y != frame_height) {
+        m_static_frame.create(frame_width, frame_height);
+        m_frame.create(frame_width, frame_height);
     }
+    m_static_generation = -1;
+}
+
+template <int field_id>
+void sfml_adapter<field_id>::render_static_layer(const field_snapshot& snap) {
+
+    float texture_width = m_static_frame.getSize().x;
+    float texture_height = m_static_frame.getSize().y;
+
+    m_terrain_layer.clear();
 
-    sf::RenderTexture texture;
-    texture.create(image_width + 2*border_width, image_height + 2*border_width);
-
-    sf::RectangleShape rect;
-    rect.setFillColor(s_border_color);
-    rect.setPosition(0, 0);
-    rect.setSize({ (float) texture.getSize().x, border_width });
-    texture.draw(rect);
-    rect.setSize({ border_width, (float) texture.getSize().y });
-    texture.draw(rect);
-    rect.setPosition(texture.getSize().x - border_width, 0);
-    rect.setSize({ border_width, (float) texture.getSize().y });
-    texture.draw(rect);
-    rect.setPosition(0, texture.getSize().y - border_width);
-    rect.setSize({ (float) texture.getSize().x, border_width });
-    texture.draw(rect);
-
-    float cell_width = image_width / m_field_p->width();
-    float cell_height = image_height / m_field_p->height();
-
-    // draw cells
-    for (int i = 0; i < m_field_p->width(); ++i) {
-        for (int j = 0; j < m_field_p->height(); ++j) {
-            sf::Sprite im_cell;
-            switch (m_field_p->get_cell_type(i, j)) {
+    texture_atlas::append_quad(m_terrain_layer, { 0, 0, texture_width, m_border_width }, m_atlas.white(), s_border_color);
+    texture_atlas::append_quad(m_terrain_layer, { 0, 0, m_border_width, texture_height }, m_atlas.white(), s_border_color);
+    texture_atlas::append_quad(m_terrain_layer, { texture_width - m_border_width, 0, m_border_width, texture_height }, m_atlas.white(), s_border_color);
+    texture_atlas::append_quad(m_terrain_layer, { 0, texture_height - m_border_width, texture_width, m_border_width }, m_atlas.white(), s_border_color);
+
+    for (int i = 0; i < snap.m_width; ++i) {
+        for (int j = 0; j < snap.m_height; ++j) {
+            switch (snap.cell_type(i, j)) {
                 case cell::GROUND:
-                    im_cell.setTexture(grass);
+                    append_sprite(m_terrain_layer, GRASS, cell_rect({ i, j }));
                     break;
                 case cell::WALL:
-                    im_cell.setTexture(wall);
+                    append_sprite(m_terrain_layer, WALL, cell_rect({ i, j }));
                     break;
             }
-            im_cell.setPosition(border_width + i * cell_width, border_width + j * cell_height);
-            im_cell.setScale(cell_width / im_cell.getLocalBounds().width, cell_height / im_cell.getLocalBounds().height);
-            texture.draw(im_cell);
         }
     }
 
-    // draw exit
-    {
-        sf::Sprite im_exit;
-        im_exit.setTexture(trapdoor);
-        im_exit.setPosition(border_width + m_field_p->get_exit_coords().first * cell_width, border_width + m_field_p->get_exit_coords().second * cell_height);
-        im_exit.setScale(cell_width / im_exit.getLocalBounds().width, cell_height / im_exit.getLocalBounds().height);
-        texture.draw(im_exit);
-    }
+    append_sprite(m_terrain_layer, TRAPDOOR, cell_rect(snap.m_exit));
 
-    // draw artifacts
-    for (const artifact* art : m_field_p->get_artifacts()) {
-        sf::Sprite im_artifact;
-        switch (art->id()) {
-            case artifact::PROTEIN:
-                im_artifact.setTexture(protein);
-                break;
-            case artifact::APPLE:
-                im_artifact.setTexture(apple);
-                break;
-            case artifact::GOLDEM_APPLE:
-                im_artifact.setTexture(golden_apple);
-                break;
-            case artifact::KNIFE:
-                im_artifact.setTexture(knife);
-                break;
-            default:
-                break;
-        }
-        im_artifact.setPosition(border_width + art->coords().first * cell_width, border_width + art->coords().second * cell_height);
-        im_artifact.setScale(cell_width / im_artifact.getLocalBounds().width, cell_height / im_artifact.getLocalBounds().height);
-        texture.draw(im_artifact);
-    }
+    m_static_frame.clear(sf::Color::Transparent);
+    m_static_frame.draw(m_terrain_layer, &m_atlas.texture());
+    m_static_frame.display();
+
+    m_static_generation = snap.m_terrain_generation;
+    m_frame_valid = false;
+}
 
-    // draw enemies
-    for (const enemy* en : m_field_p->get_enemies()) {
-        sf::Sprite im_enemy;
-        switch (en->type()) {
-            case enemy::ZOMBIE:
-                im_enemy.setTexture(zombie);
-                break;
-            case enemy::SKELETON:
-                im_enemy.setTexture(skeleton);
-                break;
+template <int field_id>
+sf::FloatRect sfml_adapter<field_id>::cell_rect(geo::i_point coords) const {
+    return cell_rect((float) coords.first, (float) coords.second);
+}
+
+template <int field_id>
+sf::FloatRect sfml_adapter<field_id>::cell_rect(float x, float y) const {
+    return {
+            m_border_width + x * m_cell_width,
+            m_border_width + y * m_cell_height,
+            m_cell_width,
+            m_cell_height
+    };
+}
+
+// A character that stepped to a neighbor cell during the last tick
+// is drawn alpha of the way from its previous cell.
+template <int field_id>
+sf::FloatRect sfml_adapter<field_id>::entity_rect(const entity_snapshot& ent, float alpha) const {
+    geo::i_point from = ent.m_previous_coords, to = ent.m_coords;
+    if (alpha >= 1 || std::abs(to.first - from.first) + std::abs(to.second - from.second) != 1)
+        return cell_rect(to);
+    return cell_rect(from.first + (to.first - from.first) * alpha, from.second + (to.second - from.second) * alpha);
+}
+
+template <int field_id>
+void sfml_adapter<field_id>::clear() {
+    m_window->clear();
+}
+
+template <int field_id>
+void sfml_adapter<field_id>::draw(const field_snapshot& snap, bool fresh) {
+
+    if (m_layout_generation != snap.m_terrain_generation
+            || m_layout_width != m_window_width || m_layout_height != m_window_height)
+        update_layout(snap);
+    if (m_static_generation != snap.m_terrain_generation)
+        render_static_layer(snap);
+
+    // the dirty cells of a skipped snapshot are lost
+    if (fresh && snap.m_sequence != m_drawn_sequence + 1)
+        m_frame_valid = false;
+
+    float alpha = 1;
+    if (m_real_time) {
+        if (snap.m_tick != m_drawn_tick) {
+            m_drawn_tick = snap.m_tick;
+            m_tick_clock.restart();
         }
-        im_enemy.setPosition(border_width + en->coords().first * cell_width, border_width + en->coords().second * cell_height);
-        im_enemy.setScale(cell_width / im_enemy.getLocalBounds().width, cell_height / im_enemy.getLocalBounds().height);
-        texture.draw(im_enemy);
-
-        sf::RectangleShape health_bar;
-        float health_percent = ((float) en->hp()) / ((float) en->max_hp());
-        health_bar.setFillColor(health_color(health_percent));
-        health_bar.setPosition(border_width + en->coords().first * cell_width, border_width + (en->coords().second + 1) * cell_height - 0.05f * cell_height);
-        health_bar.setSize({ cell_width * health_percent, 0.05f * cell_height });
-        texture.draw(health_bar);
+        alpha = std::min(1.f, m_tick_clock.getElapsedTime().asSeconds() * m_tick_rate);
     }
 
-    // draw player
-    {
-        sf::Sprite im_player;
-        im_player.setTexture(player);
-        im_player.setPosition(border_width + m_field_p->get_player().coords().first * cell_width, border_width + m_field_p->get_player().coords().second * cell_height);
-        im_player.setScale(cell_width / im_player.getLocalBounds().width, cell_height / im_player.getLocalBounds().height);
-        texture.draw(im_player);
-
-        sf::RectangleShape health_bar;
-        float health_percent = ((float) m_field_p->get_player().hp()) / ((float) m_field_p->get_player().max_hp());
-        health_bar.setFillColor(health_color(health_percent));
-        health_bar.setPosition(border_width + m_field_p->get_player().coords().first * cell_width, border_width + (m_field_p->get_player().coords().second + 1) * cell_height - 0.05f * cell_height);
-        health_bar.setSize({ cell_width * health_percent, 0.05f * cell_height });
-        texture.draw(health_bar);
-    }
+    // interpolated characters move between tiles, so dirty cells are not enough
+    if (!m_frame_valid || (fresh && snap.m_all_dirty) || alpha < 1 || m_drawn_alpha < 1)
+        redraw_all(snap, alpha);
+    else if (fresh)
+        redraw_dirty(snap);
+    m_drawn_sequence = snap.m_sequence;
+    m_drawn_alpha = alpha;
+    m_frame_valid = true;
 
-    texture.display();
+    m_frame.display();
 
     sf::Sprite sprite;
-    sprite.setTexture(texture.getTexture());
+    sprite.setTexture(m_frame.getTexture());
 
-    sprite.setPosition((m_window_width - sprite.getLocalBounds().width) / 2, (m_window_height - sprite.getLocalBounds().height) / 2);
+    sprite.setPosition((m_layout_width - sprite.getLocalBounds().width) / 2, (m_layout_height - sprite.getLocalBounds().height) / 2);
 
     m_window->draw(sprite);
 }
 
 template <int field_id>
-void sfml_adapter<field_id>::display() {
-    m_window->display();
+void sfml_adapter<field_id>::redraw_all(const field_snapshot& snap, float alpha) {
+
+    // blending off: the static layer replaces the whole previous frame
+    m_frame.draw(sf::Sprite(m_static_frame.getTexture()), sf::BlendNone);
+
+    m_entity_layer.clear();
+    for (const entity_snapshot& ent : snap.m_entities)
+        append_entity(m_entity_layer, ent, alpha);
+
+    m_frame.draw(m_entity_layer, &m_atlas.texture());
+}
+
+// Restores the static tile under every dirty cell, then draws the entities standing there.
+// Nothing is drawn outside its own cell, so the other tiles stay valid.
+template <int field_id>
+void sfml_adapter<field_id>::redraw_dirty(const field_snapshot& snap) {
+
+    const auto& dirty = snap.m_dirty_cells;
+    if (dirty.empty())
+        return;
+
+    m_dirty_mask.resize(snap.m_width * snap.m_height);
+    m_dirty_background.clear();
+    for (const auto& c : dirty) {
+        sf::FloatRect rect = cell_rect(c);
+        texture_atlas::append_quad(m_dirty_background, rect, rect);
+        m_dirty_mask.set(c.first * snap.m_height + c.second);
+    }
+
+    m_entity_layer.clear();
+    for (const entity_snapshot& ent : snap.m_entities)
+        if (m_dirty_mask.test(ent.m_coords.first * snap.m_height + ent.m_coords.second))
+            append_entity(m_entity_layer, ent, 1);
+
+    sf::RenderStates background_states (&m_static_frame.getTexture());
+    background_states.blendMode = sf::BlendNone;
+    m_frame.draw(m_dirty_background, background_states);
+    m_frame.draw(m_entity_layer, &m_atlas.texture());
+}
+
+template <int field_id>
+void sfml_adapter<field_id>::append_entity(sf::VertexArray& layer, const entity_snapshot& ent, float alpha) {
+    sf::FloatRect rect = entity_rect(ent, alpha);
+    switch (ent.m_kind) {
+        case entity::ARTIFACT:
+            switch (ent.m_subtype) {
+                case artifact::PROTEIN:
+                    append_sprite(layer, PROTEIN, rect);
+                    break;
+                case artifact::APPLE:
+                    append_sprite(layer, APPLE, rect);
+                    break;
+                case artifact::GOLDEM_APPLE:
+                    append_sprite(layer, GOLDEN_APPLE, rect);
+                    break;
+                case artifact::KNIFE:
+                    append_sprite(layer, KNIFE, rect);
+                    break;
+                default:
+                    break;
+            }
+            break;
+        case entity::ENEMY:
+            switch (ent.m_subtype) {
+                case enemy::ZOMBIE:
+                    append_sprite(layer, ZOMBIE, rect);
+                    break;
+                case enemy::SKELETON:
+                    append_sprite(layer, SKELETON, rect);
+                    break;
+            }
+            append_health_bar(layer, ent, rect);
+            break;
+        case entity::PLAYER:
+            append_sprite(layer, PLAYER, rect);
+            append_health_bar(layer, ent, rect);
+            break;
+        default:
+            break;
+    }
 }
 
 template <int field_id>
-void sfml_adapter<field_id>::refresh() {
-    clear();
-    draw();
-    display();
+void sfml_adapter<field_id>::display() {
+    m_window->display();
 }
 
 template <int field_id>
@@ -357,12 +645,33 @@ sf::Color sfml_adapter<field_id>::health_color(float percentage) {
     };
 }
 
+template <int field_id>
+void sfml_adapter<field_id>::append_sprite(sf::VertexArray& layer, sprite sp, sf::FloatRect dest) {
+    texture_atlas::append_quad(layer, dest, m_sprites[sp]);
+}
+
+template <int field_id>
+void sfml_adapter<field_id>::append_health_bar(sf::VertexArray& layer, const entity_snapshot& ch, sf::FloatRect dest) {
+    float health_percent = ((float) ch.m_hp) / ((float) ch.m_max_hp);
+    float bar_height = health_bar_ratio * dest.height;
+    texture_atlas::append_quad(layer,
+                               { dest.left, dest.top + dest.height - bar_height, dest.width * health_percent, bar_height },
+                               m_atlas.white(), health_color(health_percent));
+}
+
+template <int field_id>
+sfml_adapter<field_id>::sfml_adapter(
+        int window_width,
+        int window_height
+) : sfml_adapter(field_settings<field_id>{}, window_width, window_height) {}
+
 template <int field_id>
 sfml_adapter<field_id>::sfml_adapter(
+        field_settings<field_id> settings,
         int window_width,
         int window_height
 ) : m_window_width(window_width), m_window_height(window_height), m_window(nullptr), m_event_getter(nullptr) {
-    set_game(game_s_ptr(new Game<field_id>()));
+    set_game(game_s_ptr(new Game<field_id>(nullptr, settings)));
     load_images();
 }
 
@@ -397,12 +706,109 @@ const typename sfml_adapter<field_id>::field_s_ptr& sfml_adapter<field_id>::get_
     return m_field_p;
 }
 
+template <int field_id>
+bool sfml_adapter<field_id>::real_time() const {
+    return m_real_time;
+}
+
+template <int field_id>
+void sfml_adapter<field_id>::set_real_time(bool real_time) {
+    m_real_time = real_time;
+    m_field_p->set_instant_step_on_action(!real_time);
+    m_previous_coords.clear();
+}
+
+template <int field_id>
+float sfml_adapter<field_id>::tick_rate() const {
+    return m_tick_rate;
+}
+
+template <int field_id>
+void sfml_adapter<field_id>::set_tick_rate(float ticks_per_second) {
+    if (ticks_per_second > 0)
+        m_tick_rate = ticks_per_second;
+}
+
+template <int field_id>
+unsigned sfml_adapter<field_id>::frame_limit() const {
+    return m_frame_limit;
+}
+
+template <int field_id>
+void sfml_adapter<field_id>::set_frame_limit(unsigned frames_per_second) {
+    m_frame_limit = frames_per_second;
+    apply_video_settings();
+}
+
+template <int field_id>
+bool sfml_adapter<field_id>::vsync() const {
+    return m_vsync;
+}
+
+template <int field_id>
+void sfml_adapter<field_id>::set_vsync(bool vsync) {
+    m_vsync = vsync;
+    apply_video_settings();
+}
+
+template <int field_id>
+int sfml_adapter<field_id>::autosave_interval() const {
+    return m_saves.autosave_interval();
+}
+
+template <int field_id>
+void sfml_adapter<field_id>::set_autosave_interval(int turns) {
+    m_saves.set_autosave_interval(turns);
+}
+
+// Input and simulation loop; frames are drawn meanwhile by the render thread,
+// paced by the frame limit or vsync. Turn-based it blocks on input, as nothing
+// moves by itself; real-time it steps the field at m_tick_rate with a fixed timestep.
+// A snapshot is published after anything that may have changed the field.
 template <int field_id>
 void sfml_adapter<field_id>::start() {
     create_window();
+    publish();
+
+    sf::Clock clock;
+    sf::Time lag = sf::Time::Zero;
+
     while (m_window->isOpen()) {
-        handle_event(m_event_getter.wait_event());
-        refresh();
+
+        bool changed = false;
+
+        sf::Event event;
+        if (!m_real_time) {
+            handle_event(m_event_getter.wait_event());
+            changed = true;
+        }
+        while (m_event_getter.poll_event(event)) {
+            handle_event(event);
+            changed = true;
+        }
+        if (!m_window->isOpen())
+            break;
+
+        if (m_real_time) {
+            sf::Time tick_time = sf::seconds(1.f / m_tick_rate);
+            lag += clock.restart();
+            int ticks = 0;
+            while (lag >= tick_time && ticks < max_ticks_per_frame) {
+                tick();
+                lag -= tick_time;
+                ++ticks;
+            }
+            // too far behind (e.g. the window was dragged): drop the backlog instead of catching up
+            if (lag >= tick_time)
+                lag = sf::Time::Zero;
+            if (ticks > 0)
+                changed = true;
+            if (changed)
+                publish();
+            sf::sleep(std::min(tick_time - lag, max_input_latency));
+        } else if (changed) {
+            publish();
+        }
     }
 }
 
@@ -14,11 +14,8 @@ void sfml_event_getter::set_window(RenderWindow* window) {
     m_window = window;
 }
 
-sf::Event sfml_event_getter::poll_event() {
-    sf::Event event;
-    if (m_window != nullptr)
-        m_window->pollEvent(event);
-    return event;
+bool sfml_event_getter::poll_event(sf::Event& event) {
+    return m_window != nullptr && m_window->pollEvent(event);
 }
 
 sf::Event sfml_event_getter::wait_event() {
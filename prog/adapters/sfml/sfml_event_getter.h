@@ -13,7 +13,7 @@ public:
     RenderWindow* get_window();
     const RenderWindow* get_window() const;
     void set_window(RenderWindow* window);
-    sf::Event poll_event() override;
+    bool poll_event(sf::Event& event) override;
     sf::Event wait_event() override;
 };
 
@@ -0,0 +1,120 @@
+#include "texture_atlas.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <stdexcept>
+
+#include "../../../lib/containers/vector/Vector.h"
+#include "../../../lib/algorithm/sorts/heapsort.h"
+
+void texture_atlas::load(const std::string& directory) {
+
+    struct entry {
+        std::string m_name;
+        sf::Image m_image;
+    };
+
+    Vector<entry> entries;
+
+    for (const auto& file : std::filesystem::directory_iterator(directory)) {
+        if (!file.is_regular_file() || file.path().extension() != IMAGE_EXTENSION)
+            continue;
+        entry e { file.path().filename().string(), {} };
+        if (!e.m_image.loadFromFile(file.path().string()))
+            throw std::runtime_error(LOAD_ERROR);
+        entries.add(std::move(e));
+    }
+
+    // the white square goes in as an image of its own
+    {
+        entry e { "", {} };
+        e.m_image.create(white_size, white_size, sf::Color::White);
+        entries.add(std::move(e));
+    }
+
+    // shelf packing: tallest first, rows of roughly square total area
+    heapsort(entries.begin(), entries.end(), [](const entry& a, const entry& b) {
+        return a.m_image.getSize().y > b.m_image.getSize().y;
+    });
+
+    unsigned area = 0, widest = 0;
+    for (const entry& e : entries) {
+        area += (e.m_image.getSize().x + padding) * (e.m_image.getSize().y + padding);
+        widest = std::max(widest, e.m_image.getSize().x + padding);
+    }
+    unsigned atlas_width = std::max(widest, (unsigned) std::ceil(std::sqrt((double) area)));
+
+    Vector<sf::IntRect> placed (entries.size());
+    unsigned x = 0, y = 0, shelf_height = 0;
+    for (const entry& e : entries) {
+        sf::Vector2u size = e.m_image.getSize();
+        if (x + size.x > atlas_width) {
+            x = 0;
+            y += shelf_height + padding;
+            shelf_height = 0;
+        }
+        placed.add(sf::IntRect(x, y, size.x, size.y));
+        x += size.x + padding;
+        shelf_height = std::max(shelf_height, size.y);
+    }
+    unsigned atlas_height = y + shelf_height;
+
+    if (atlas_width > sf::Texture::getMaximumSize() || atlas_height > sf::Texture::getMaximumSize())
+        throw std::runtime_error(SIZE_ERROR);
+
+    sf::Image atlas;
+    atlas.create(atlas_width, atlas_height, sf::Color::Transparent);
+    m_rects.clear();
+    for (int i = 0; i < entries.size(); ++i) {
+        atlas.copy(entries[i].m_image, placed[i].left, placed[i].top);
+        if (entries[i].m_name.empty())
+            m_white = placed[i];
+        else
+            m_rects[entries[i].m_name] = placed[i];
+    }
+
+    if (!m_texture.loadFromImage(atlas))
+        throw std::runtime_error(LOAD_ERROR);
+}
+
+const sf::Texture& texture_atlas::texture() const {
+    return m_texture;
+}
+
+const sf::IntRect& texture_atlas::rect(const std::string& name) const {
+    auto it = m_rects.find(name);
+    if (it == m_rects.end())
+        throw std::runtime_error(UNKNOWN_IMAGE_ERROR);
+    return it->second;
+}
+
+bool texture_atlas::contains(const std::string& name) const {
+    return m_rects.find(name) != m_rects.end();
+}
+
+sf::IntRect texture_atlas::white() const {
+    return { m_white.left + 1, m_white.top + 1, m_white.width - 2, m_white.height - 2 };
+}
+
+void texture_atlas::append_quad(sf::VertexArray& vertices, const sf::FloatRect& dest, const sf::IntRect& src,
+                                const sf::Color& color) {
+    append_quad(vertices, dest, sf::FloatRect(src), color);
+}
+
+void texture_atlas::append_quad(sf::VertexArray& vertices, const sf::FloatRect& dest, const sf::FloatRect& src,
+                                const sf::Color& color) {
+    std::size_t first = vertices.getVertexCount();
+    vertices.resize(first + 4);
+    set_quad(vertices, first, dest, src, color);
+}
+
+void texture_atlas::set_quad(sf::VertexArray& vertices, std::size_t first, const sf::FloatRect& dest,
+                             const sf::FloatRect& src, const sf::Color& color) {
+    float left = src.left, top = src.top;
+    float right = src.left + src.width, bottom = src.top + src.height;
+    vertices[first + 0] = sf::Vertex({ dest.left, dest.top }, color, { left, top });
+    vertices[first + 1] = sf::Vertex({ dest.left + dest.width, dest.top }, color, { right, top });
+    vertices[first + 2] = sf::Vertex({ dest.left + dest.width, dest.top + dest.height }, color, { right, bottom });
+    vertices[first + 3] = sf::Vertex({ dest.left, dest.top + dest.height }, color, { left, bottom });
+}
\ No newline at end of file
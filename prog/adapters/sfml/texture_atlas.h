@@ -0,0 +1,52 @@
+#ifndef GAME_TEXTURE_ATLAS_H
+#define GAME_TEXTURE_ATLAS_H
+
+#include <map>
+#include <string>
+
+#include <SFML/Graphics.hpp>
+
+// All images of a directory packed into one texture, so a whole layer
+// can be drawn as a single sf::VertexArray with one texture bound.
+// A small white square is packed too: untextured quads (borders, health bars)
+// sample it and get their color from the vertices.
+class texture_atlas {
+
+    inline static const char *const IMAGE_EXTENSION = ".png";
+
+    inline static const char *const LOAD_ERROR = "Cannot load image into the atlas.";
+    inline static const char *const SIZE_ERROR = "Texture atlas exceeds the maximum texture size.";
+    inline static const char *const UNKNOWN_IMAGE_ERROR = "Unknown atlas image.";
+
+    inline static const int padding = 1;
+    inline static const int white_size = 4;
+
+    sf::Texture m_texture;
+    std::map<std::string, sf::IntRect> m_rects;
+    sf::IntRect m_white;
+
+public:
+
+    // packs every IMAGE_EXTENSION file of the directory, keyed by file name
+    void load(const std::string& directory);
+
+    const sf::Texture& texture() const;
+
+    const sf::IntRect& rect(const std::string& name) const;
+    bool contains(const std::string& name) const;
+
+    // the inner texels of the white square, away from its edges
+    sf::IntRect white() const;
+
+    // appends one textured quad; src is in texture pixels
+    static void append_quad(sf::VertexArray& vertices, const sf::FloatRect& dest, const sf::IntRect& src,
+                            const sf::Color& color = sf::Color::White);
+    static void append_quad(sf::VertexArray& vertices, const sf::FloatRect& dest, const sf::FloatRect& src,
+                            const sf::Color& color = sf::Color::White);
+
+    // overwrites the quad starting at vertex index first
+    static void set_quad(sf::VertexArray& vertices, std::size_t first, const sf::FloatRect& dest, const sf::FloatRect& src,
+                         const sf::Color& color = sf::Color::White);
+};
+
+#endif //GAME_TEXTURE_ATLAS_H
\ No newline at end of file
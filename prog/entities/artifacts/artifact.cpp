@@ -70,30 +70,43 @@ const Vector<artifact::artifact_info> artifact::artifact_infos = {
         }
 };
 
-artifact::artifact(artifact_id id, geo::i_point coords) : entity(coords), m_id(id) {}
+artifact::artifact(artifact_id id, geo::i_point coords) : entity(ARTIFACT, id, coords) {}
 
 artifact::artifact_id artifact::id() const {
-    return m_id;
+    return (artifact_id) subtype();
 }
 
 void artifact::act(artifact* art, character* ch) {
-    artifact_infos[art->m_id].m_action(ch);
+    artifact_infos[art->id()].m_action(ch);
 }
 
 void artifact::react(artifact* art, character* ch) {
-    artifact_infos[art->m_id].m_reaction(ch);
+    artifact_infos[art->id()].m_reaction(ch);
 }
 
 void artifact::save(std::ostream& out) const {
     entity::save(out);
-    out << m_id << '\n';
+    out << id() << '\n';
 }
 
 void artifact::load(std::istream& in) {
     entity::load(in);
     int id;
     in >> id;
-    m_id = (artifact_id) id;
-    if (in.fail())
+    if (in.fail() || id < 0 || id >= artifact_infos.size())
         throw load_error{};
+    set_subtype(id);
+}
+
+void artifact::save(binary_writer& out) const {
+    entity::save(out);
+    out.write<std::int32_t>(id());
+}
+
+void artifact::load(binary_reader& in) {
+    entity::load(in);
+    std::int32_t id = in.read<std::int32_t>();
+    if (id < 0 || id >= artifact_infos.size())
+        throw load_error{};
+    set_subtype(id);
 }
\ No newline at end of file
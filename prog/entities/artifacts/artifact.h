@@ -35,10 +35,10 @@ private:
 
     static const Vector<artifact_info> artifact_infos;
 
-    artifact_id m_id;
-
 public:
 
+    static constexpr kind_type kind_tag = ARTIFACT;
+
     artifact(artifact_id id, geo::i_point coords = { -1, -1 });
 
     artifact_id id() const;
@@ -48,6 +48,8 @@ public:
 
     void save(std::ostream &out) const override;
     void load(std::istream &in) override;
+    void save(binary_writer &out) const override;
+    void load(binary_reader &in) override;
 };
 
 #endif //GAME_ARTIFACT_H
\ No newline at end of file
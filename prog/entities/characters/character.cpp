@@ -6,8 +6,24 @@ void character::print(std::ostream& out) const {
     out << "character{ coords=" << coords() << ", max_hp=" << max_hp() << ", hp=" << hp() << ", damage=" << damage() << ", is_melee=" << melee() << ", is_alive=" << alive() << ", artifacts=" << m_artifacts << " }";
 }
 
+void character::fill_record(log_record& record) const {
+    entity::fill_record(record);
+    record.set_type("character");
+    record.add("max_hp", max_hp());
+    record.add("hp", hp());
+    record.add("damage", damage());
+    record.add("is_melee", melee());
+    record.add("is_alive", alive());
+    record.add("artifacts", m_artifacts.size());
+}
+
 character::character(geo::i_point coords, int max_hp, int hp, int damage, bool melee)
-: entity(coords), m_max_hp(max_hp), m_hp(hp), m_damage(damage), m_melee(melee) {}
+: entity(CHARACTER, 0, coords), m_max_hp(max_hp), m_hp(hp), m_damage(damage), m_melee(melee) {}
+
+character::character(kind_type kind, unsigned char subtype, geo::i_point coords)
+: entity(kind, subtype, coords),
+  m_max_hp(default_initial_max_hp), m_hp(default_initial_hp),
+  m_damage(default_initial_damage), m_melee(default_initial_melee) {}
 
 character::~character() {
     for (artifact* art : m_artifacts)
@@ -66,20 +82,23 @@ bool character::dead() const {
 void character::attack(character* other) {
     other->m_hp -= m_damage;
     other->check_hp();
-    other->notify();
+    if (other->dead())
+        other->notify<log_category::LIFECYCLE, log_level::WARNING>();
+    else
+        other->notify<log_category::COMBAT>();
 }
 
 void character::get_artifact(artifact* art) {
     artifact::act(art, this);
     m_artifacts.add(art);
-    notify();
+    notify<log_category::INVENTORY>();
 }
 
 [[nodiscard]] artifact* character::remove_artifact(int index) {
     artifact* art = m_artifacts[index];
     artifact::react(art, this);
     m_artifacts.remove(index);
-    notify();
+    notify<log_category::INVENTORY>();
     return art;
 }
 
@@ -94,7 +113,7 @@ void character::delete_artifact(int index) {
             artifact* art = m_artifacts[i];
             artifact::react(art, this);
             m_artifacts.remove(i);
-            notify();
+            notify<log_category::INVENTORY>();
             return art;
         }
     }
@@ -140,4 +159,34 @@ void character::load(std::istream& in) {
         if (in.fail())
             throw load_error{};
     }
+}
+
+void character::save(binary_writer& out) const {
+    entity::save(out);
+    out.write<std::int32_t>(m_max_hp);
+    out.write<std::int32_t>(m_hp);
+    out.write<std::int32_t>(m_damage);
+    out.write<std::uint8_t>(m_melee);
+    out.write<std::uint8_t>(m_alive);
+    out.write<std::uint32_t>(m_artifacts.size());
+    for (artifact* art : m_artifacts)
+        art->save(out);
+}
+
+void character::load(binary_reader& in) {
+    entity::load(in);
+    m_max_hp = in.read<std::int32_t>();
+    m_hp = in.read<std::int32_t>();
+    m_damage = in.read<std::int32_t>();
+    m_melee = in.read<std::uint8_t>();
+    m_alive = in.read<std::uint8_t>();
+    std::uint32_t size = in.read<std::uint32_t>();
+    // every artifact takes more than one byte: a corrupt count fails here, not in resize
+    if (size > in.remaining())
+        throw load_error{};
+    m_artifacts.resize(size);
+    for (int i = 0; i < (int) size; ++i) {
+        m_artifacts[i] = new artifact((artifact::artifact_id) -1);
+        m_artifacts[i]->load(in);
+    }
 }
\ No newline at end of file
@@ -23,10 +23,15 @@ protected:
 
     Vector<artifact*> m_artifacts {};
 
+    character(kind_type kind, unsigned char subtype, geo::i_point coords);
+
     void print(std::ostream &out) const override;
+    void fill_record(log_record& record) const override;
 
 public:
 
+    static constexpr kind_type kind_tag = CHARACTER;
+
     inline static const int
             default_initial_max_hp = 100,
             default_initial_hp = 100,
@@ -69,6 +74,8 @@ public:
 
     void save(std::ostream &out) const override;
     void load(std::istream &in) override;
+    void save(binary_writer &out) const override;
+    void load(binary_reader &in) override;
 };
 
 #endif //GAME_CHARACTER_H
\ No newline at end of file
@@ -3,23 +3,27 @@
 #include "../../../field/field.h"
 #include "../../../../lib/algorithm/sorts/heapsort.h"
 
-const enemy::strategy enemy::default_melee_strategy = [](const enemy& en, const field& f) -> action {
+const enemy::strategy enemy::default_melee_strategy = [](const enemy& en, const field& f, Pcg32& rng) -> action {
 
     class comp {
         const enemy& m_en;
         const field& m_field;
         const Matrix<int>& m_distances;
+        Pcg32& m_rng;
     public:
-        comp(const enemy& en, const field& f, const Matrix<int>& distances) : m_en(en), m_field(f), m_distances(distances) {}
+        comp(const enemy& en, const field& f, const Matrix<int>& distances, Pcg32& rng)
+        : m_en(en), m_field(f), m_distances(distances), m_rng(rng) {}
         bool operator()(const geo::i_point& p1, const geo::i_point& p2) {
             int dist_diff = m_distances[p1.first][p1.second] - m_distances[p2.first][p2.second];
             if (dist_diff != 0)
                 return dist_diff < 0;
-            entity* p1_ent = m_field.m_cells[p1.first][p1.second]->get_entity();
-            entity* p2_ent = m_field.m_cells[p2.first][p2.second]->get_entity();
-            if ((p1_ent == nullptr || typeid(*p1_ent) != typeid(enemy)) && p2_ent != nullptr && typeid(*p2_ent) == typeid(enemy))
+            const entity* p1_ent = m_field.m_cells(p1.first, p1.second).get_entity();
+            const entity* p2_ent = m_field.m_cells(p2.first, p2.second).get_entity();
+            bool p1_enemy = p1_ent != nullptr && p1_ent->is<enemy>();
+            bool p2_enemy = p2_ent != nullptr && p2_ent->is<enemy>();
+            if (!p1_enemy && p2_enemy)
                 return true;
-            else if (p1_ent != nullptr && typeid(*p1_ent) == typeid(enemy) && (p2_ent == nullptr || typeid(*p2_ent) != typeid(enemy)))
+            else if (p1_enemy && !p2_enemy)
                 return false;
             const auto& player_coords = m_field.get_player().coords();
             const int player_enemy_coords_diff =
@@ -29,39 +33,30 @@ const enemy::strategy enemy::default_melee_strategy = [](const enemy& en, const
             } else if (player_enemy_coords_diff > 0 /* x > y */) {
                 return std::abs(player_coords.first - p1.second) < std::abs(player_coords.first - p2.second);
             } else /* x == y */ {
-                return std::rand() < RAND_MAX / 2;
+                return m_rng.next_bool();
             }
         }
     };
 
-    Vector<geo::i_point> neighbors = f.get_neighbors(en.coords());
+    geo::i_point neighbors[neighbor_range::count];
+    int count = 0;
 
-    for (int i = 0; i < neighbors.size();) {
-        if (f.m_distances[neighbors[i].first][neighbors[i].second] == field::distance_unvisited) {
-            neighbors.remove(i);
-        } else {
-            ++i;
-        }
-    }
+    for (const auto& n : f.get_neighbors(en.coords()))
+        if (f.m_distances[n.first][n.second] != field::distance_unvisited)
+            neighbors[count++] = n;
 
-    if (neighbors.empty()) {
+    if (count == 0) {
 
-        neighbors = f.get_neighbors(en.coords());
+        for (const auto& n : f.get_neighbors(en.coords()))
+            if (f.m_distances_throw_enemies[n.first][n.second] != field::distance_unvisited)
+                neighbors[count++] = n;
 
-        for (int i = 0; i < neighbors.size();) {
-            if (f.m_distances_throw_enemies[neighbors[i].first][neighbors[i].second] == field::distance_unvisited) {
-                neighbors.remove(i);
-            } else {
-                ++i;
-            }
-        }
-
-        if (neighbors.empty())
+        if (count == 0)
             return action(action::DO_NOTHING, { -1, -1 });
 
-        heapsort(neighbors.begin(), neighbors.end(), comp(en, f, f.m_distances_throw_enemies));
+        heapsort(neighbors, neighbors + count, comp(en, f, f.m_distances_throw_enemies, rng));
     } else {
-        heapsort(neighbors.begin(), neighbors.end(), comp(en, f, f.m_distances));
+        heapsort(neighbors, neighbors + count, comp(en, f, f.m_distances, rng));
     }
 
     return action(action::TRY_TO_MOVE_ELSE_ATTACK, neighbors[0]);
@@ -90,32 +85,50 @@ void enemy::print(std::ostream& out) const {
     out << "enemy{ coords=" << coords() << ", type=" << type() << ", max_hp=" << max_hp() << ", hp=" << hp() << ", damage=" << damage() << ", is_melee=" << melee() << ", is_alive=" << alive() << ", artifacts=" << m_artifacts << " }";
 }
 
-enemy::enemy(enemy::enemy_type type, geo::i_point coords) : character(coords) {
-    m_type = type;
-    m_max_hp = enemy_infos[m_type].m_max_hp;
-    m_hp = enemy_infos[m_type].m_hp;
-    m_damage = enemy_infos[m_type].m_damage;
-    m_melee = enemy_infos[m_type].m_melee;
+void enemy::fill_record(log_record& record) const {
+    character::fill_record(record);
+    record.set_type("enemy");
+    record.add("type", type());
+}
+
+enemy::enemy(enemy::enemy_type type, geo::i_point coords) : character(ENEMY, type, coords) {
+    m_max_hp = enemy_infos[type].m_max_hp;
+    m_hp = enemy_infos[type].m_hp;
+    m_damage = enemy_infos[type].m_damage;
+    m_melee = enemy_infos[type].m_melee;
 }
 
 enemy::enemy_type enemy::type() const {
-    return m_type;
+    return (enemy_type) subtype();
 }
 
-action enemy::get_action(const field& f) {
-    return enemy_infos[m_type].m_strategy(*this, f);
+action enemy::get_action(const field& f, Pcg32& rng) {
+    return enemy_infos[type()].m_strategy(*this, f, rng);
 }
 
 void enemy::save(std::ostream& out) const {
     character::save(out);
-    out << m_type << '\n';
+    out << type() << '\n';
 }
 
 void enemy::load(std::istream& in) {
     character::load(in);
     int type;
     in >> type;
-    if (in.fail())
+    if (in.fail() || type < 0 || type >= enemy_infos.size())
+        throw load_error{};
+    set_subtype(type);
+}
+
+void enemy::save(binary_writer& out) const {
+    character::save(out);
+    out.write<std::int32_t>(type());
+}
+
+void enemy::load(binary_reader& in) {
+    character::load(in);
+    std::int32_t type = in.read<std::int32_t>();
+    if (type < 0 || type >= enemy_infos.size())
         throw load_error{};
-    m_type = (enemy_type) type;
+    set_subtype(type);
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <functional>
 
 #include "../character.h"
+#include "../../../../lib/utils/random/Pcg32.h"
 #include "../../../field/action.h"
 
 class field; // pre-declaration
@@ -12,7 +13,7 @@ class enemy : public character {
 
 public:
 
-    using strategy = std::function<action(const enemy&, const field&)>;
+    using strategy = std::function<action(const enemy&, const field&, Pcg32&)>;
 
     enum enemy_type {
         ZOMBIE = 0,
@@ -34,22 +35,25 @@ private:
 
     static const strategy default_melee_strategy;
 
-    enemy_type m_type;
-
 protected:
 
     void print(std::ostream &out) const override;
+    void fill_record(log_record& record) const override;
 
 public:
 
+    static constexpr kind_type kind_tag = ENEMY;
+
     enemy(enemy_type type, geo::i_point coords = { -1, -1 });
 
     enemy_type type() const;
 
-    action get_action(const field& f);
+    action get_action(const field& f, Pcg32& rng);
 
     void save(std::ostream &out) const override;
     void load(std::istream &in) override;
+    void save(binary_writer &out) const override;
+    void load(binary_reader &in) override;
 };
 
 #endif //GAME_ENEMY_H
\ No newline at end of file
@@ -4,7 +4,12 @@ void player::print(std::ostream& out) const {
     out << "player{ coords=" << coords() << ", max_hp=" << max_hp() << ", hp=" << hp() << ", damage=" << damage() << ", is_melee=" << melee() << ", is_alive=" << alive() << ", artifacts=" << m_artifacts << " }";
 }
 
-player::player(geo::i_point coords) : character(coords) {}
+void player::fill_record(log_record& record) const {
+    character::fill_record(record);
+    record.set_type("player");
+}
+
+player::player(geo::i_point coords) : character(PLAYER, 0, coords) {}
 
 direction player::dir() {
     return m_dir;
@@ -26,4 +31,14 @@ void player::load(std::istream& in) {
     if (in.fail())
         throw load_error{};
     m_dir = (direction) dir;
+}
+
+void player::save(binary_writer& out) const {
+    character::save(out);
+    out.write<std::int32_t>((int) m_dir);
+}
+
+void player::load(binary_reader& in) {
+    character::load(in);
+    m_dir = (direction) in.read<std::int32_t>();
 }
\ No newline at end of file
@@ -11,9 +11,12 @@ class player : public character {
 protected:
 
     void print(std::ostream &out) const override;
+    void fill_record(log_record& record) const override;
 
 public:
 
+    static constexpr kind_type kind_tag = PLAYER;
+
     player(geo::i_point coords = { -1, -1 });
 
     direction dir();
@@ -21,6 +24,8 @@ public:
 
     void save(std::ostream &out) const override;
     void load(std::istream &in) override;
+    void save(binary_writer &out) const override;
+    void load(binary_reader &in) override;
 };
 
 #endif //GAME_PLAYER_H
\ No newline at end of file
@@ -1,20 +1,45 @@
 #include "entity.h"
 
-entity::entity(geo::i_point coords) : m_coords(coords) {
-    notify();
+void* entity::operator new(std::size_t size) {
+    return arena::allocate_current(size);
+}
+
+void entity::operator delete(void* ptr) {
+    arena::deallocate(ptr);
+}
+
+entity::entity(geo::i_point coords) : entity(ENTITY, 0, coords) {}
+
+entity::entity(kind_type kind, unsigned char subtype, geo::i_point coords)
+: m_kind(kind), m_subtype(subtype), m_coords(coords) {
+    notify<log_category::LIFECYCLE, log_level::DEBUG>();
+}
+
+void entity::set_subtype(unsigned char subtype) {
+    m_subtype = subtype;
+}
+
+void entity::set_uid(std::uint32_t uid) {
+    m_uid = uid;
 }
 
 void entity::print(std::ostream& out) const {
     out << "entity{ coords=" << coords() << " }";
 }
 
+void entity::fill_record(log_record& record) const {
+    record.m_id = uid();
+    record.set_type("entity");
+    record.add("coords", coords().first, coords().second);
+}
+
 const geo::i_point& entity::coords() const {
     return m_coords;
 }
 
 void entity::set_coords(geo::i_point coords) {
     m_coords = coords;
-    notify();
+    notify<log_category::MOVEMENT, log_level::DEBUG>();
 }
 
 void entity::save(std::ostream& out) const {
@@ -28,4 +53,14 @@ void entity::load(std::istream& in) {
     in >> m_coords.second;
     if (in.fail())
         throw load_error{};
+}
+
+void entity::save(binary_writer& out) const {
+    out.write<std::int32_t>(m_coords.first);
+    out.write<std::int32_t>(m_coords.second);
+}
+
+void entity::load(binary_reader& in) {
+    m_coords.first = in.read<std::int32_t>();
+    m_coords.second = in.read<std::int32_t>();
 }
\ No newline at end of file
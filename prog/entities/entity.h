@@ -1,29 +1,89 @@
 #ifndef GAME_ENTITY_H
 #define GAME_ENTITY_H
 
+#include <cstddef>
+#include <cstdint>
+
 #include "../geometry/geo.h"
+#include "../../lib/utils/arena/arena.h"
 #include "../../lib/utils/logger/Observable.h"
 #include "../../lib/utils/sarialization/Savable.h"
 
 class entity : public Observable, Savable {
 
+public:
+
+    // Bit flags: a kind includes the bits of every base it derives from,
+    // so is<T>() is one mask test instead of a dynamic_cast.
+    enum kind_type : unsigned char {
+        ENTITY    = 0,
+        CHARACTER = 1,
+        PLAYER    = CHARACTER | 2,
+        ENEMY     = CHARACTER | 4,
+        ARTIFACT  = 8
+    };
+
+    static constexpr kind_type kind_tag = ENTITY;
+
+private:
+
+    kind_type m_kind;
+    unsigned char m_subtype; // enemy_type / artifact_id, 0 for others
+    std::uint32_t m_uid = 0; // given by the field, never reused by it; 0 until then
+
 protected:
 
     geo::i_point m_coords;
 
     entity(geo::i_point coords = { -1, -1 });
+    entity(kind_type kind, unsigned char subtype, geo::i_point coords = { -1, -1 });
+
+    void set_subtype(unsigned char subtype);
 
     void print(std::ostream &out) const override;
+    void fill_record(log_record& record) const override;
 
 public:
 
     ~entity() override = default;
 
+    // from the arena of the field being built (arena::scope), the heap otherwise
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr);
+
+    kind_type kind() const;
+    unsigned char subtype() const;
+
+    std::uint32_t uid() const;
+    void set_uid(std::uint32_t uid);
+
+    template <typename T>
+    bool is() const;
+
     const geo::i_point& coords() const;
     void set_coords(geo::i_point coords);
 
     void save(std::ostream &out) const override;
     void load(std::istream &in) override;
+    void save(binary_writer &out) const override;
+    void load(binary_reader &in) override;
 };
 
+template <typename T>
+bool entity::is() const {
+    return (m_kind & T::kind_tag) == T::kind_tag;
+}
+
+inline entity::kind_type entity::kind() const {
+    return m_kind;
+}
+
+inline unsigned char entity::subtype() const {
+    return m_subtype;
+}
+
+inline std::uint32_t entity::uid() const {
+    return m_uid;
+}
+
 #endif //GAME_ENTITY_H
\ No newline at end of file
@@ -5,7 +5,8 @@ template <typename event_type>
 class abstract_event_getter {
 public:
     virtual ~abstract_event_getter() = default;
-    virtual event_type poll_event() = 0;
+    // false when there is no pending event, the argument is left untouched then
+    virtual bool poll_event(event_type& event) = 0;
     virtual event_type wait_event() = 0;
 };
 
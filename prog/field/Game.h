@@ -14,14 +14,15 @@ private:
 
 public:
 
-    Game(std::shared_ptr<Logger> logger = nullptr);
+    Game(std::shared_ptr<Logger> logger = nullptr, field_settings<field_id> settings = {});
 
     std::shared_ptr<field> get_field();
     const std::shared_ptr<field>& get_field() const;
 };
 
 template <int field_id>
-Game<field_id>::Game(std::shared_ptr<Logger> logger) : m_field(new field(field_settings<field_id>{}, logger)) {}
+Game<field_id>::Game(std::shared_ptr<Logger> logger, field_settings<field_id> settings)
+: m_field(new field(settings, logger)) {}
 
 template <int field_id>
 std::shared_ptr<field> Game<field_id>::get_field() {
@@ -1,13 +1,6 @@
 #include "cell.h"
 
-cell::cell(cell::cell_type type, entity* ent) : m_type(type) {
-    set_entity(ent);
-}
-
-cell::~cell() {
-    delete m_entity;
-    m_entity = nullptr;
-}
+cell::cell(cell::cell_type type, entity* ent) : m_type(type), m_entity(ent) {}
 
 cell::cell_type& cell::type() {
     return m_type;
@@ -31,4 +24,12 @@ const entity *const & cell::get_entity() const {
 
 void cell::set_entity(entity* ent) {
     m_entity = ent;
+}
+
+neighbor_range::mask_type cell::neighbors() const {
+    return m_neighbors;
+}
+
+void cell::set_neighbors(neighbor_range::mask_type mask) {
+    m_neighbors = mask;
 }
\ No newline at end of file
@@ -2,11 +2,14 @@
 #define GAME_CELL_H
 
 #include "../../entities/entity.h"
+#include "neighbors.h"
 
+// Stored by value in the field grid. The occupant is not owned:
+// the field deletes entities through its player/enemy/artifact lists.
 class cell {
 public:
 
-    enum cell_type {
+    enum cell_type : unsigned char {
         GROUND,
         WALL
     };
@@ -14,13 +17,12 @@ public:
 private:
 
     cell_type m_type;
+    neighbor_range::mask_type m_neighbors = 0;
     entity* m_entity;
 
 public:
 
-    cell(cell_type type, entity* ent = nullptr);
-
-    ~cell();
+    cell(cell_type type = GROUND, entity* ent = nullptr);
 
     cell_type& type();
     const cell_type& type() const;
@@ -29,6 +31,9 @@ public:
     entity*& get_entity();
     const entity *const & get_entity() const;
     void set_entity(class entity* ent);
+
+    neighbor_range::mask_type neighbors() const;
+    void set_neighbors(neighbor_range::mask_type mask);
 };
 
 #endif //GAME_CELL_H
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef GAME_NEIGHBORS_H
+#define GAME_NEIGHBORS_H
+
+#include "../../geometry/geo.h"
+
+// Passable neighbors of a cell as a 4-bit mask, iterated without allocating.
+// Bit order is left, up, right, down.
+class neighbor_range {
+
+public:
+
+    using mask_type = unsigned char;
+
+    inline static const int count = 4;
+    inline static const int dx[count] = { -1, 0, 1, 0 };
+    inline static const int dy[count] = { 0, -1, 0, 1 };
+
+    class iterator {
+        geo::i_point m_origin;
+        mask_type m_mask;
+    public:
+        iterator(geo::i_point origin, mask_type mask) : m_origin(origin), m_mask(mask) {}
+        geo::i_point operator*() const {
+            int bit = __builtin_ctz(m_mask);
+            return { m_origin.first + dx[bit], m_origin.second + dy[bit] };
+        }
+        iterator& operator++() {
+            m_mask &= m_mask - 1;
+            return *this;
+        }
+        bool operator==(const iterator& other) const {
+            return m_mask == other.m_mask;
+        }
+        bool operator!=(const iterator& other) const {
+            return !operator==(other);
+        }
+    };
+
+private:
+
+    geo::i_point m_origin;
+    mask_type m_mask;
+
+public:
+
+    neighbor_range(geo::i_point origin, mask_type mask) : m_origin(origin), m_mask(mask) {}
+
+    mask_type mask() const {
+        return m_mask;
+    }
+
+    int size() const {
+        return __builtin_popcount(m_mask);
+    }
+
+    bool empty() const {
+        return m_mask == 0;
+    }
+
+    iterator begin() const {
+        return { m_origin, m_mask };
+    }
+
+    iterator end() const {
+        return { m_origin, 0 };
+    }
+};
+
+#endif //GAME_NEIGHBORS_H
\ No newline at end of file
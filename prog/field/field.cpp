@@ -1,5 +1,14 @@
 #include "field.h"
 
+#include <climits>
+
+#include "../../lib/algorithm/sorts/heapsort.h"
+#include "../../lib/utils/sarialization/atomic_file.h"
+#include "../../lib/utils/sarialization/binary_file.h"
+#include "../../lib/utils/sarialization/fnv1a.h"
+#include "../../lib/utils/sarialization/mapped_file.h"
+#include "replay.h"
+
 const Vector<field::field_template> field::field_templates = {
         {
             0,
@@ -257,89 +266,297 @@ const Vector<field::field_template> field::field_templates = {
         }
 };
 
-Vector<geo::i_point> field::get_neighbors(geo::i_point coords) const {
+int field::index(geo::i_point coords) const {
+    return coords.first * m_height + coords.second;
+}
 
-    Vector<geo::i_point> neighbors (4);
+neighbor_range field::get_neighbors(geo::i_point coords) const {
+    return { coords, m_cells(coords.first, coords.second).neighbors() };
+}
 
-    if (coords.first - 1 >= 0 && coords.first - 1 < width())
-        if (coords.second >= 0 && coords.second < height())
-            neighbors.add({ coords.first - 1, coords.second });
-    if (coords.first >= 0 && coords.first < width())
-        if (coords.second - 1 >= 0 && coords.second - 1 < height())
-            neighbors.add({ coords.first, coords.second - 1 });
-    if (coords.first + 1 >= 0 && coords.first + 1 < width())
-        if (coords.second >= 0 && coords.second < height())
-            neighbors.add({ coords.first + 1, coords.second });
-    if (coords.first >= 0 && coords.first < width())
-        if (coords.second + 1 >= 0 && coords.second + 1 < height())
-            neighbors.add({ coords.first, coords.second + 1 });
+// Cells live in m_cells by value, so on restart this reuses the same allocation.
+void field::reset_terrain() {
+    ++m_terrain_generation;
+    m_cells.resize(m_width, m_height);
+    m_walkable.resize(m_width * m_height);
+    m_dirty_mask.resize(m_width * m_height);
+    m_dirty_cells.clear();
+    m_all_dirty = true;
+}
 
-    return neighbors;
+// Fills the grid from the level template.
+void field::build_terrain() {
+    reset_terrain();
+    for (int x = 0; x < m_width; ++x) {
+        for (int y = 0; y < m_height; ++y) {
+            char c = field_templates[m_id].m_cells[y][x];
+            switch (c) {
+                case CELL_GROUND_SYMBOL:
+                    m_cells(x, y) = cell(cell::GROUND);
+                    m_walkable.set(index({ x, y }));
+                    break;
+                case CELL_WALL_SYMBOL:
+                    m_cells(x, y) = cell(cell::WALL);
+                    break;
+                default:
+                    throw std::runtime_error(UNKNOWN_CELL_SYMBOL);
+            }
+        }
+    }
+    build_adjacency();
 }
 
-void field::evaluate_distances() {
+// Fills the grid from saved cell types, one byte per cell in the order
+// of m_cells. Reads straight from the save, e.g. a mapped file.
+void field::build_terrain(const char* types) {
+    reset_terrain();
+    cell* cells = m_cells.data();
+    for (int i = 0; i < m_width * m_height; ++i) {
+        auto type = (cell::cell_type) types[i];
+        switch (type) {
+            case cell::GROUND:
+                cells[i] = cell(cell::GROUND);
+                m_walkable.set(i);
+                break;
+            case cell::WALL:
+                cells[i] = cell(cell::WALL);
+                break;
+            default:
+                throw load_error{};
+        }
+    }
+    build_adjacency();
+}
 
-    Queue<Pair<geo::i_point,int>> q;
-    for (int x = 0; x < width(); ++x) {
-        for (int y = 0; y < height(); ++y) {
-            m_distances[x][y] = distance_unvisited;
-            m_distances_throw_enemies[x][y] = distance_unvisited;
+// Walls only change when a level is loaded, so the passable neighbors
+// of every cell are computed once per load.
+void field::build_adjacency() {
+    for (int x = 0; x < m_width; ++x) {
+        for (int y = 0; y < m_height; ++y) {
+            neighbor_range::mask_type mask = 0;
+            for (int i = 0; i < neighbor_range::count; ++i) {
+                int nx = x + neighbor_range::dx[i];
+                int ny = y + neighbor_range::dy[i];
+                if (nx >= 0 && nx < m_width && ny >= 0 && ny < m_height && m_cells(nx, ny).type() != cell::WALL)
+                    mask |= 1 << i;
+            }
+            m_cells(x, y).set_neighbors(mask);
         }
     }
-    m_distances[m_player->coords().first][m_player->coords().second] = 0;
-    m_distances_throw_enemies[m_player->coords().first][m_player->coords().second] = 0;
+}
+
+// only meant for ground cells: walls are never in a neighbor range
+bool field::occupied_by_enemy(geo::i_point coords) const {
+    return !m_walkable.test(index(coords));
+}
+
+// Loaded entities are placed straight into m_cells, so their coordinates
+// have to name a ground cell of the grid.
+void field::check_on_ground(geo::i_point coords) const {
+    if (coords.first < 0 || coords.first >= m_width || coords.second < 0 || coords.second >= m_height
+        || m_cells(coords.first, coords.second).type() != cell::GROUND)
+        throw load_error{};
+}
+
+// A cell holds one entity; placing another one on it would leave the
+// first in its list without a cell.
+void field::check_placeable(geo::i_point coords) const {
+    check_on_ground(coords);
+    if (m_cells(coords.first, coords.second).get_entity() != nullptr)
+        throw load_error{};
+}
+
+void field::evaluate_distances() {
+    evaluate_distances(m_distances, false);
+    evaluate_distances(m_distances_throw_enemies, true);
+    m_distances_actual = true;
+}
+
+void field::evaluate_distances(Matrix<int>& distances, bool throw_enemies) const {
+
+    auto& q = m_bfs_queue;
+    distances.fill(distance_unvisited);
+    distances[m_player->coords().first][m_player->coords().second] = 0;
 
     q.push({ m_player->coords(), 0 });
     while (!q.empty()) {
         auto cur = q.pop();
-        std::initializer_list<geo::i_point> neighbors = {
-                { cur.first.first - 1, cur.first.second },
-                { cur.first.first, cur.first.second - 1 },
-                { cur.first.first + 1, cur.first.second },
-                { cur.first.first, cur.first.second + 1 }
-        };
-        for (const auto& n : neighbors) {
-            if (n.first >= 0 && n.first < width() && n.second >= 0 && n.second < height()) {
-                if (m_cells[n.first][n.second]->type() != cell::WALL) {
-                    if (!type_utils::instanceof<enemy>(*m_cells[n.first][n.second]->get_entity())) {
-                        if (m_distances[n.first][n.second] == distance_unvisited) {
-                            int distance = cur.second + 1;
-                            m_distances[n.first][n.second] = distance;
-                            q.push({n, distance});
-                        }
-                    }
+        for (const auto& n : get_neighbors(cur.first)) {
+            if (distances[n.first][n.second] == distance_unvisited) {
+                if (throw_enemies || !occupied_by_enemy(n)) {
+                    int distance = cur.second + 1;
+                    distances[n.first][n.second] = distance;
+                    q.push({ n, distance });
                 }
             }
         }
     }
+}
 
-    q.push({ m_player->coords(), 0 });
+void field::ensure_distances() {
+    if (!m_distances_actual)
+        evaluate_distances();
+}
+
+// Cell became passable for m_distances (an enemy left or died).
+// Only cells whose distance decreases are touched.
+void field::release_distances(geo::i_point coords) {
+
+    int best = distance_unvisited;
+    for (const auto& n : get_neighbors(coords))
+        if (m_distances[n.first][n.second] != distance_unvisited)
+            best = std::min(best, m_distances[n.first][n.second] + 1);
+
+    if (best == distance_unvisited)
+        return;
+
+    auto& q = m_bfs_queue;
+    m_distances[coords.first][coords.second] = best;
+    q.push({ coords, best });
     while (!q.empty()) {
         auto cur = q.pop();
-        std::initializer_list<geo::i_point> neighbors = {
-                { cur.first.first - 1, cur.first.second },
-                { cur.first.first, cur.first.second - 1 },
-                { cur.first.first + 1, cur.first.second },
-                { cur.first.first, cur.first.second + 1 }
-        };
-        for (const auto& n : neighbors) {
-            if (n.first >= 0 && n.first < width() && n.second >= 0 && n.second < height()) {
-                if (m_cells[n.first][n.second]->type() != cell::WALL) {
-                    if (m_distances_throw_enemies[n.first][n.second] == distance_unvisited) {
-                        int distance = cur.second + 1;
-                        m_distances_throw_enemies[n.first][n.second] = distance;
-                        q.push({ n, distance });
-                    }
+        for (const auto& n : get_neighbors(cur.first)) {
+            if (occupied_by_enemy(n))
+                continue;
+            int distance = cur.second + 1;
+            if (distance < m_distances[n.first][n.second]) {
+                m_distances[n.first][n.second] = distance;
+                q.push({ n, distance });
+            }
+        }
+    }
+}
+
+// Cell became blocked for m_distances (an enemy entered it).
+// First collects cells that lost every shortest path to the player,
+// then recomputes only them, seeded from their unaffected borders.
+void field::block_distances(geo::i_point coords) {
+
+    int old_distance = m_distances[coords.first][coords.second];
+    if (old_distance == distance_unvisited)
+        return;
+
+    Vector<geo::i_point> affected;
+    auto& q = m_bfs_queue;
+
+    // cells are popped in order of their old distance, so every affected
+    // parent of a cell is already marked when the cell itself is checked
+    m_distances[coords.first][coords.second] = distance_unvisited;
+    q.push({ coords, old_distance });
+    while (!q.empty()) {
+        auto cur = q.pop();
+        for (const auto& n : get_neighbors(cur.first)) {
+            if (m_distances[n.first][n.second] != cur.second + 1)
+                continue;
+            bool supported = false;
+            for (const auto& p : get_neighbors(n)) {
+                if (m_distances[p.first][p.second] == cur.second) {
+                    supported = true;
+                    break;
                 }
             }
+            if (!supported) {
+                m_distances[n.first][n.second] = distance_unvisited;
+                affected.add(n);
+                q.push({ n, cur.second + 1 });
+            }
+        }
+    }
+
+    Vector<Pair<geo::i_point,int>> seeds (affected.size());
+    for (const auto& a : affected) {
+        int best = distance_unvisited;
+        for (const auto& n : get_neighbors(a))
+            if (m_distances[n.first][n.second] != distance_unvisited)
+                best = std::min(best, m_distances[n.first][n.second] + 1);
+        if (best != distance_unvisited) {
+            m_distances[a.first][a.second] = best;
+            seeds.add({ a, best });
         }
     }
+    heapsort(seeds.begin(), seeds.end(), [](const Pair<geo::i_point,int>& a, const Pair<geo::i_point,int>& b) {
+        return a.second < b.second;
+    });
+
+    // unit-weight Dijkstra: merging sorted seeds with the FIFO queue keeps
+    // the pop order monotone, so every cell enters the queue at most once
+    int next_seed = 0;
+    while (next_seed < seeds.size() || !q.empty()) {
+        Pair<geo::i_point,int> cur;
+        if (q.empty() || (next_seed < seeds.size() && seeds[next_seed].second <= q.front().second))
+            cur = seeds[next_seed++];
+        else
+            cur = q.pop();
+        if (m_distances[cur.first.first][cur.first.second] < cur.second)
+            continue;
+        for (const auto& n : get_neighbors(cur.first)) {
+            if (!occupied_by_enemy(n) && cur.second + 1 < m_distances[n.first][n.second]) {
+                m_distances[n.first][n.second] = cur.second + 1;
+                q.push({ n, cur.second + 1 });
+            }
+        }
+    }
+}
+
+void field::check_distances() const {
+    Matrix<int> distances (m_width, m_height);
+    evaluate_distances(distances, false);
+    if (!std::equal(distances.span().begin(), distances.span().end(), m_distances.span().begin()))
+        throw std::runtime_error(DISTANCES_MISMATCH_ERROR);
+}
+
+void field::mark_dirty(geo::i_point coords) {
+    int i = index(coords);
+    if (m_all_dirty || m_dirty_mask.test(i))
+        return;
+    m_dirty_mask.set(i);
+    m_dirty_cells.add(coords);
+}
+
+void field::on_enemy_left(geo::i_point coords) {
+    m_walkable.set(index(coords));
+    if (!m_incremental_distances || !m_distances_actual) {
+        m_distances_actual = false;
+        return;
+    }
+    release_distances(coords);
+#ifdef GAME_DEBUG_DISTANCES
+    check_distances();
+#endif
+}
+
+void field::on_enemy_entered(geo::i_point coords) {
+    m_walkable.reset(index(coords));
+    if (!m_incremental_distances || !m_distances_actual) {
+        m_distances_actual = false;
+        return;
+    }
+    block_distances(coords);
+#ifdef GAME_DEBUG_DISTANCES
+    check_distances();
+#endif
+}
+
+// Entities keep their uid when they move between lists.
+void field::assign_uid(entity* ent) {
+    if (ent->uid() == 0)
+        ent->set_uid(m_next_uid++);
 }
 
 void field::move_character(character* c, geo::i_point coords) {
-    m_cells[c->coords().first][c->coords().second]->set_entity(nullptr);
-    delete m_cells[coords.first][coords.second]->get_entity();
-    m_cells[coords.first][coords.second]->set_entity(c);
+    bool is_enemy = c->is<enemy>();
+    mark_dirty(c->coords());
+    mark_dirty(coords);
+    journal_changed(c);
+    m_cells(c->coords().first, c->coords().second).set_entity(nullptr);
+    if (is_enemy)
+        on_enemy_left(c->coords());
+    else
+        m_distances_actual = false;
+    delete m_cells(coords.first, coords.second).get_entity();
+    m_cells(coords.first, coords.second).set_entity(c);
+    if (is_enemy)
+        on_enemy_entered(coords);
     c->set_coords(coords);
 }
 
@@ -377,20 +594,20 @@ void field::handle_character_action(character* c, action act) {
     if (next_coords.second < 0 || next_coords.second >= height())
         return;
 
-    cell* cel = m_cells[next_coords.first][next_coords.second];
+    cell& cel = m_cells(next_coords.first, next_coords.second);
 
-    if (cel->type() == cell::WALL)
+    if (cel.type() == cell::WALL)
         return;
 
-    entity* ent = cel->get_entity();
+    entity* ent = cel.get_entity();
 
     switch (act.m_type) {
         case action::MOVE:
             if (ent == nullptr) {
                 move_character(c, next_coords);
-            } else if (type_utils::instanceof<artifact>(*ent)) {
+            } else if (ent->is<artifact>()) {
                 c->get_artifact(remove_artifact((artifact*) ent));
-                cel->set_entity(nullptr);
+                cel.set_entity(nullptr);
                 move_character(c, next_coords);
             }
             break;
@@ -398,8 +615,12 @@ void field::handle_character_action(character* c, action act) {
             if (ent == nullptr) {
                 break;
             } else {
-                if (type_utils::instanceof<character>(*ent)) {
-                    if (!type_utils::same_type(*c, *ent) || act.m_friendly_fire) {
+                if (ent->is<character>()) {
+                    if (c->kind() != ent->kind() || act.m_friendly_fire) {
+                        mark_dirty(c->coords());
+                        mark_dirty(next_coords);
+                        journal_changed(c);
+                        journal_changed(ent);
                         c->attack((character*)ent);
                         check_if_character_dead((character*)ent);
                     }
@@ -410,14 +631,18 @@ void field::handle_character_action(character* c, action act) {
             if (ent == nullptr) {
                 move_character(c, next_coords);
             } else {
-                if (type_utils::instanceof<character>(*ent)) {
-                    if (!type_utils::same_type(*c, *ent) || act.m_friendly_fire) {
+                if (ent->is<character>()) {
+                    if (c->kind() != ent->kind() || act.m_friendly_fire) {
+                        mark_dirty(c->coords());
+                        mark_dirty(next_coords);
+                        journal_changed(c);
+                        journal_changed(ent);
                         c->attack((character*)ent);
                         check_if_character_dead((character*)ent);
                     }
-                } else if (type_utils::instanceof<artifact>(*ent)) {
+                } else if (ent->is<artifact>()) {
                     c->get_artifact(remove_artifact((artifact*) ent));
-                    cel->set_entity(nullptr);
+                    cel.set_entity(nullptr);
                     move_character(c, next_coords);
                 }
             }
@@ -429,47 +654,67 @@ void field::handle_character_action(character* c, action act) {
 
 void field::players_turn() {
     handle_character_action(m_player, { action::TRY_TO_MOVE_ELSE_ATTACK, m_player->dir() });
-    if (m_player->dir() != direction::NONE && m_player->dir() != direction::UNDEFINED)
-        evaluate_distances();
+    ensure_distances();
 }
 
 void field::enemies_turn() {
     for (enemy* e : m_enemies) {
-        handle_character_action(e, e->get_action(*this));
-        evaluate_distances();
+        handle_character_action(e, e->get_action(*this, m_rng));
+        ensure_distances();
     }
 }
 
 void field::step() {
     if (m_game_condition != game_condition::RUNNING)
         return;
+    ++m_turn;
+    if (m_logger != nullptr)
+        m_logger->tick(m_turn);
     players_turn();
     if (m_player->coords() == m_exit) {
         m_game_condition = game_condition::WIN;
-        return;
+    } else {
+        enemies_turn();
+        m_player->set_dir(direction::NONE);
     }
-    enemies_turn();
-    m_player->set_dir(direction::NONE);
+    if (m_journal != nullptr)
+        journal_turn();
 }
 
 void field::check_if_character_dead(character* c) {
     if (c->dead()) {
         if (c == m_player) {
             m_game_condition = game_condition::LOSE;
-        } else if (type_utils::instanceof<enemy>(*c)) {
+        } else if (c->is<enemy>()) {
             delete_enemy((enemy*)c);
         }
     }
 }
 
 void field::save() {
-    std::ofstream out(SAVE_FILENAME);
-    save(out);
+    write_save(capture_save());
 }
 
+// The binary save goes first; the text one is still read so that
+// older saves keep working.
 void field::load(bool try_from_file) {
 
+    arena::scope entities(m_arena);
+
     if (try_from_file) {
+        // mapped rather than read: the terrain is built from the mapped bytes
+        mapped_file file;
+        if (file.open(BINARY_SAVE_FILENAME)) {
+            try {
+                std::uint32_t version;
+                binary_reader in = binary_file::open(file.data(), file.size(), BINARY_SAVE_MAGIC,
+                                                     OLDEST_BINARY_SAVE_VERSION, BINARY_SAVE_VERSION, version);
+                load(in, version);
+                return;
+            } catch (load_error) {
+                clear();
+            }
+        }
         std::ifstream in(SAVE_FILENAME);
         try {
             load(in);
@@ -483,60 +728,47 @@ void field::load(bool try_from_file) {
     m_height = field_templates[m_id].m_height;
     m_entry = field_templates[m_id].m_entry;
     m_exit = field_templates[m_id].m_exit;
-    m_cells = Matrix<cell*>(m_width, m_height);
-    m_distances = Matrix<int>(m_width, m_height);
-    m_distances_throw_enemies = Matrix<int>(m_width, m_height);
+    m_distances.resize(m_width, m_height);
+    m_distances_throw_enemies.resize(m_width, m_height);
 
     m_game_condition = game_condition::RUNNING;
 
     m_player = new player(m_entry);
+    assign_uid(m_player);
 
-    for (int x = 0; x < m_width; ++x) {
-        for (int y = 0; y < m_height; ++y) {
-            char c = field_templates[m_id].m_cells[y][x];
-            switch (c) {
-                case CELL_GROUND_SYMBOL:
-                    m_cells[x][y] = new cell(cell::GROUND);
-                    break;
-                case CELL_WALL_SYMBOL:
-                    m_cells[x][y] = new cell(cell::WALL);
-                    break;
-                default:
-                    throw std::runtime_error(UNKNOWN_CELL_SYMBOL);
-            }
-        }
-    }
+    build_terrain();
 
     field_templates[m_id].enemies_generator(*this);
     field_templates[m_id].artifacts_generator(*this);
 
     move_character(m_player, m_entry);
-    evaluate_distances();
 }
 
 void field::reload() {
     clear();
     load(false);
+    apply_logger();
+    if (m_journal != nullptr) {
+        // the template and the rng state are all it takes to reload
+        m_journal->append_restart();
+        forget_journal_changes();
+    }
 }
 
+// Keeps the grid and the arena blocks, the next load overwrites every cell
+// and allocates its entities from the start of the arena again.
 void field::clear() {
-    if (m_player != nullptr
-        && m_player->coords().first >= 0 && m_player->coords().first < width()
-        && m_player->coords().second >= 0 && m_player->coords().second < height()
-        && m_cells[m_player->coords().first][m_player->coords().second] != nullptr)
-        m_cells[m_player->coords().first][m_player->coords().second]->set_entity(nullptr);
+    m_distances_actual = false;
+    for (cell& c : m_cells.span())
+        c.set_entity(nullptr);
     delete m_player;
     m_player = nullptr;
     while (!m_enemies.empty())
         delete_enemy(m_enemies.size() - 1);
     while (!m_artifacts.empty())
         delete_artifact(m_artifacts.size() - 1);
-    for (int x = 0; x < m_cells.width(); ++x) {
-        for (int y = 0; y < m_cells.height(); ++y) {
-            delete m_cells[x][y];
-            m_cells[x][y] = nullptr;
-        }
-    }
+    m_arena.reset();
+    forget_journal_changes();
 }
 
 void field::apply_logger() {
@@ -545,19 +777,19 @@ void field::apply_logger() {
         en->setLogger(m_logger);
 }
 
-field::field(int id, std::shared_ptr<Logger> logger)
-    : m_id(id), m_logger(logger) {
-    load();
+field::field(int id, std::shared_ptr<Logger> logger, bool try_from_file, std::uint64_t seed)
+    : m_id(id), m_logger(logger), m_rng(seed) {
+    load(try_from_file);
     apply_logger();
 }
 
-field::field(field_settings<0> settings, std::shared_ptr<Logger> logger) : field(0, logger) {}
-field::field(field_settings<1> settings, std::shared_ptr<Logger> logger) : field(1, logger) {}
-field::field(field_settings<2> settings, std::shared_ptr<Logger> logger) : field(2, logger) {}
-field::field(field_settings<3> settings, std::shared_ptr<Logger> logger) : field(3, logger) {}
-field::field(field_settings<4> settings, std::shared_ptr<Logger> logger) : field(4, logger) {}
-field::field(field_settings<5> settings, std::shared_ptr<Logger> logger) : field(5, logger) {}
-field::field(field_settings<6> settings, std::shared_ptr<Logger> logger) : field(6, logger) {}
+field::field(field_settings<0> settings, std::shared_ptr<Logger> logger) : field(0, logger, true, settings.get_seed()) {}
+field::field(field_settings<1> settings, std::shared_ptr<Logger> logger) : field(1, logger, true, settings.get_seed()) {}
+field::field(field_settings<2> settings, std::shared_ptr<Logger> logger) : field(2, logger, true, settings.get_seed()) {}
+field::field(field_settings<3> settings, std::shared_ptr<Logger> logger) : field(3, logger, true, settings.get_seed()) {}
+field::field(field_settings<4> settings, std::shared_ptr<Logger> logger) : field(4, logger, true, settings.get_seed()) {}
+field::field(field_settings<5> settings, std::shared_ptr<Logger> logger) : field(5, logger, true, settings.get_seed()) {}
+field::field(field_settings<6> settings, std::shared_ptr<Logger> logger) : field(6, logger, true, settings.get_seed()) {}
 
 field::~field() {
     clear();
@@ -594,6 +826,8 @@ void field::send_sygnal(sygnal signal) {
         default:
             throw std::runtime_error(UNKNOWN_SIGNAL_ERROR);
     }
+    if (m_recorder != nullptr)
+        m_recorder->record(signal, *this);
 }
 
 int field::width() const {
@@ -605,18 +839,18 @@ int field::height() const {
 }
 
 cell::cell_type field::get_cell_type(int x, int y) const {
-    return m_cells[x][y]->type();
+    return m_cells(x, y).type();
 }
 
 const player& field::get_player() const {
     return *m_player;
 }
 
-const Vector<enemy*> field::get_enemies() const {
+const Vector<enemy*>& field::get_enemies() const {
     return m_enemies;
 }
 
-const Vector<artifact*> field::get_artifacts() const {
+const Vector<artifact*>& field::get_artifacts() const {
     return m_artifacts;
 }
 
@@ -628,24 +862,86 @@ geo::i_point field::get_exit_coords() const {
     return m_exit;
 }
 
+int field::terrain_generation() const {
+    return m_terrain_generation;
+}
+
+const entity* field::get_occupant(int x, int y) const {
+    return m_cells(x, y).get_entity();
+}
+
+const Vector<geo::i_point>& field::get_dirty_cells() const {
+    return m_dirty_cells;
+}
+
+// set after a (re)load: everything must be redrawn, the list is not kept
+bool field::all_dirty() const {
+    return m_all_dirty;
+}
+
+void field::clear_dirty() {
+    for (const auto& c : m_dirty_cells)
+        m_dirty_mask.reset(index(c));
+    m_dirty_cells.clear();
+    m_all_dirty = false;
+}
+
 game_condition field::get_game_condition() const {
     return m_game_condition;
 }
 
+unsigned long long field::turn() const {
+    return m_turn;
+}
+
+bool field::instant_step_on_action() const {
+    return m_instant_step_on_action;
+}
+
+void field::set_instant_step_on_action(bool instant) {
+    m_instant_step_on_action = instant;
+}
+
+const Pcg32& field::get_rng() const {
+    return m_rng;
+}
+
+void field::seed(std::uint64_t seed) {
+    m_rng.seed(seed);
+}
+
+bool field::incremental_distances() const {
+    return m_incremental_distances;
+}
+
+void field::set_incremental_distances(bool incremental) {
+    m_incremental_distances = incremental;
+}
+
 void field::add_enemy(enemy* en) {
+    assign_uid(en);
+    journal_changed(en);
     m_enemies.add(en);
-    m_cells[en->coords().first][en->coords().second]->set_entity(en);
+    m_cells(en->coords().first, en->coords().second).set_entity(en);
+    mark_dirty(en->coords());
+    on_enemy_entered(en->coords());
 }
 
 void field::add_artifact(artifact* art) {
+    assign_uid(art);
+    journal_changed(art);
     m_artifacts.add(art);
-    m_cells[art->coords().first][art->coords().second]->set_entity(art);
+    m_cells(art->coords().first, art->coords().second).set_entity(art);
+    mark_dirty(art->coords());
 }
 
 enemy* field::remove_enemy(int index) {
     enemy* ret = m_enemies[index];
+    journal_removed(ret);
     m_enemies.remove(index);
-    m_cells[ret->coords().first][ret->coords().second]->set_entity(nullptr);
+    m_cells(ret->coords().first, ret->coords().second).set_entity(nullptr);
+    mark_dirty(ret->coords());
+    on_enemy_left(ret->coords());
     return ret;
 }
 
@@ -655,8 +951,10 @@ void field::delete_enemy(int index) {
 
 artifact* field::remove_artifact(int index) {
     artifact* ret = m_artifacts[index];
+    journal_removed(ret);
     m_artifacts.remove(index);
-    m_cells[ret->coords().first][ret->coords().second]->set_entity(nullptr);
+    m_cells(ret->coords().first, ret->coords().second).set_entity(nullptr);
+    mark_dirty(ret->coords());
     return ret;
 }
 
@@ -690,6 +988,70 @@ void field::delete_artifact(artifact* ptr) {
     delete remove_artifact(ptr);
 }
 
+std::uint64_t field::state_hash() const {
+    binary_writer out;
+    save(out);
+    return fnv1a::compute(out.data(), out.size());
+}
+
+std::shared_ptr<replay::recorder> field::get_recorder() {
+    return m_recorder;
+}
+
+void field::set_recorder(std::shared_ptr<replay::recorder> recorder) {
+    m_recorder = recorder;
+}
+
+std::shared_ptr<turn_journal> field::get_journal() {
+    return m_journal;
+}
+
+void field::set_journal(std::shared_ptr<turn_journal> journal) {
+    m_journal = journal;
+    forget_journal_changes();
+    if (m_journal != nullptr)
+        journal_checkpoint();
+}
+
+void field::recover(const char* journal_filename) {
+    turn_journal::reader journal (journal_filename);
+    binary_writer before;
+    save(before);
+    save_uids(before);
+    // nothing is recorded while replaying
+    std::shared_ptr<turn_journal> attached = std::move(m_journal);
+    m_journal = nullptr;
+    try {
+        turn_journal::record_type type;
+        binary_reader payload (nullptr, 0);
+        bool loaded = false;
+        while (journal.next(type, payload)) {
+            if (type == turn_journal::CHECKPOINT) {
+                load(payload);
+                load_uids(payload);
+                loaded = true;
+            } else if (type == turn_journal::TURN && loaded) {
+                apply_turn(payload);
+            } else if (type == turn_journal::RESTART && loaded) {
+                reload();
+            } else {
+                throw load_error{};
+            }
+        }
+        if (!loaded)
+            throw load_error{};
+    } catch (...) {
+        binary_reader in (before.data(), before.size());
+        load(in);
+        load_uids(in);
+        apply_logger();
+        m_journal = std::move(attached);
+        throw;
+    }
+    m_journal = std::move(attached);
+    apply_logger();
+}
+
 std::shared_ptr<Logger> field::get_logger() {
     return m_logger;
 }
@@ -705,13 +1067,7 @@ void field::save(std::ostream& out) const {
     << m_exit.first << ' ' << m_exit.second << ' '
     << m_instant_step_on_action << ' ' << (int) m_game_condition << '\n';
 
-    for (const auto& column : m_distances)
-        for (int d : column)
-            out << d << ' ';
-
-    for (const auto& column : m_distances_throw_enemies)
-        for (int d : column)
-            out << d << ' ';
+    m_rng.save(out);
 
     m_player->save(out);
     out << m_enemies.size() << '\n';
@@ -724,6 +1080,8 @@ void field::save(std::ostream& out) const {
 
 void field::load(std::istream& in) {
 
+    arena::scope entities(m_arena);
+
     clear();
 
     in >> m_id;
@@ -735,13 +1093,13 @@ void field::load(std::istream& in) {
     in >> m_height;
     if (in.fail())
         throw load_error{};
+    // the terrain comes from the template, so the grid has to be its size
+    if (m_id < 0 || m_id >= field_templates.size()
+        || m_width != field_templates[m_id].m_width || m_height != field_templates[m_id].m_height)
+        throw load_error{};
 
-    m_cells = Matrix<cell*>(m_width, m_height);
-    for (auto& column : m_cells)
-        for (cell*& c : column)
-            c = nullptr;
-    m_distances = Matrix<int>(m_width, m_height);
-    m_distances_throw_enemies = Matrix<int>(m_width, m_height);
+    m_distances.resize(m_width, m_height);
+    m_distances_throw_enemies.resize(m_width, m_height);
 
     in >> m_entry.first;
     if (in.fail())
@@ -764,60 +1122,378 @@ void field::load(std::istream& in) {
         throw load_error{};
     m_game_condition = (game_condition) game_cond;
 
-    for (auto& column : m_distances) {
-        for (int& d : column) {
-            in >> d;
-            if (in.fail())
-                throw load_error{};
-        }
-    }
-
-    for (auto& column : m_distances_throw_enemies) {
-        for (int& d : column) {
-            in >> d;
-            if (in.fail())
-                throw load_error{};
-        }
-    }
+    m_rng.load(in);
 
     // setting cells
 
-    for (int x = 0; x < m_width; ++x) {
-        for (int y = 0; y < m_height; ++y) {
-            char c = field_templates[m_id].m_cells[y][x];
-            switch (c) {
-                case CELL_GROUND_SYMBOL:
-                    m_cells[x][y] = new cell(cell::GROUND);
-                    break;
-                case CELL_WALL_SYMBOL:
-                    m_cells[x][y] = new cell(cell::WALL);
-                    break;
-                default:
-                    throw std::runtime_error(UNKNOWN_CELL_SYMBOL);
-            }
-        }
-    }
+    build_terrain();
 
     m_player = new player{};
     m_player->load(in);
+    assign_uid(m_player);
     int size;
     in >> size;
     if (in.fail())
         throw load_error{};
     for (int i = 0; i < size; ++i) {
-        enemy* en = new enemy(enemy::ZOMBIE);
+        std::unique_ptr<enemy> en (new enemy(enemy::ZOMBIE));
         en->load(in);
-        add_enemy(en);
+        check_placeable(en->coords());
+        add_enemy(en.release());
     }
     in >> size;
     if (in.fail())
         throw load_error{};
     for (int i = 0; i < size; ++i) {
-        artifact* art = new artifact((artifact::artifact_id) -1);
+        std::unique_ptr<artifact> art (new artifact((artifact::artifact_id) -1));
         art->load(in);
-        add_artifact(art);
+        check_placeable(art->coords());
+        add_artifact(art.release());
     }
 
+    check_placeable(m_player->coords());
     move_character(m_player, m_player->coords());
-    evaluate_distances();
+}
+
+void field::save(binary_writer& out) const {
+    save_header(out);
+    const std::string& terrain = *saved_terrain();
+    out.write_bytes(terrain.data(), terrain.size());
+    save_entities(out);
+}
+
+void field::save_header(binary_writer& out) const {
+    out.write<std::int32_t>(m_id);
+    out.write<std::int32_t>(m_width);
+    out.write<std::int32_t>(m_height);
+    out.write<std::int32_t>(m_entry.first);
+    out.write<std::int32_t>(m_entry.second);
+    out.write<std::int32_t>(m_exit.first);
+    out.write<std::int32_t>(m_exit.second);
+    out.write<std::uint8_t>(m_instant_step_on_action);
+    out.write<std::uint8_t>((int) m_game_condition);
+
+    m_rng.save(out);
+}
+
+void field::save_entities(binary_writer& out) const {
+    m_player->save(out);
+    out.write<std::uint32_t>(m_enemies.size());
+    for (const enemy* en : m_enemies)
+        en->save(out);
+    out.write<std::uint32_t>(m_artifacts.size());
+    for (const artifact* art : m_artifacts)
+        art->save(out);
+}
+
+// one byte per cell in the order of m_cells, see build_terrain(const char*)
+const std::shared_ptr<const std::string>& field::saved_terrain() const {
+    if (m_saved_terrain_generation != m_terrain_generation) {
+        auto terrain = std::make_shared<std::string>(m_cells.size(), '\0');
+        const cell* cells = m_cells.data();
+        for (int i = 0; i < m_cells.size(); ++i)
+            (*terrain)[i] = (char) cells[i].type();
+        m_saved_terrain = std::move(terrain);
+        m_saved_terrain_generation = m_terrain_generation;
+    }
+    return m_saved_terrain;
+}
+
+save_snapshot field::capture_save() const {
+    save_snapshot snap;
+    save_header(snap.m_head);
+    snap.m_terrain = saved_terrain();
+    save_entities(snap.m_tail);
+    snap.m_turn = m_turn;
+    return snap;
+}
+
+bool field::write_save(const save_snapshot& snap) {
+    binary_writer buffer (binary_file::header_size + snap.m_head.size() + snap.m_terrain->size() + snap.m_tail.size());
+    binary_file::begin(buffer);
+    buffer.write_bytes(snap.m_head.data(), snap.m_head.size());
+    buffer.write_bytes(snap.m_terrain->data(), snap.m_terrain->size());
+    buffer.write_bytes(snap.m_tail.data(), snap.m_tail.size());
+    binary_file::finish(buffer, BINARY_SAVE_MAGIC, BINARY_SAVE_VERSION);
+    return atomic_file::replace(BINARY_SAVE_FILENAME, buffer.data(), buffer.size());
+}
+
+void field::load(binary_reader& in) {
+    load(in, BINARY_SAVE_VERSION);
+}
+
+void field::load(binary_reader& in, std::uint32_t version) {
+
+    arena::scope entities(m_arena);
+
+    clear();
+
+    m_id = in.read<std::int32_t>();
+    m_width = in.read<std::int32_t>();
+    m_height = in.read<std::int32_t>();
+    if (m_id < 0 || m_id >= field_templates.size() || m_width <= 0 || m_height <= 0)
+        throw load_error{};
+    if (version < 3) {
+        // the terrain comes from the template, so the grid has to be its size
+        if (m_width != field_templates[m_id].m_width || m_height != field_templates[m_id].m_height)
+            throw load_error{};
+    } else {
+        // one terrain byte per cell follows, so a grid larger than the rest is corrupt
+        std::size_t cells = (std::size_t) m_width * m_height;
+        if (cells > INT_MAX || cells > in.remaining())
+            throw load_error{};
+    }
+
+    m_distances.resize(m_width, m_height);
+    m_distances_throw_enemies.resize(m_width, m_height);
+
+    m_entry.first = in.read<std::int32_t>();
+    m_entry.second = in.read<std::int32_t>();
+    m_exit.first = in.read<std::int32_t>();
+    m_exit.second = in.read<std::int32_t>();
+    m_instant_step_on_action = in.read<std::uint8_t>();
+    m_game_condition = (game_condition) in.read<std::uint8_t>();
+
+    m_rng.load(in);
+
+    // derived from the rest, rebuilt on first use
+    if (version < 2)
+        in.read_bytes(2 * (std::size_t) m_width * m_height * sizeof(std::int32_t));
+
+    // setting cells
+
+    if (version < 3)
+        build_terrain();
+    else
+        build_terrain(in.read_bytes((std::size_t) m_width * m_height));
+
+    m_player = new player{};
+    m_player->load(in);
+    assign_uid(m_player);
+    std::uint32_t size = in.read<std::uint32_t>();
+    for (std::uint32_t i = 0; i < size; ++i) {
+        std::unique_ptr<enemy> en (new enemy(enemy::ZOMBIE));
+        en->load(in);
+        check_placeable(en->coords());
+        add_enemy(en.release());
+    }
+    size = in.read<std::uint32_t>();
+    for (std::uint32_t i = 0; i < size; ++i) {
+        std::unique_ptr<artifact> art (new artifact((artifact::artifact_id) -1));
+        art->load(in);
+        check_placeable(art->coords());
+        add_artifact(art.release());
+    }
+
+    check_placeable(m_player->coords());
+    move_character(m_player, m_player->coords());
+}
+
+// Journal bookkeeping is skipped entirely while no journal is attached.
+void field::journal_changed(entity* ent) {
+    if (m_journal == nullptr)
+        return;
+    for (entity* e : m_journal_changed)
+        if (e == ent)
+            return;
+    m_journal_changed.add(ent);
+}
+
+void field::journal_removed(const entity* ent) {
+    if (m_journal == nullptr)
+        return;
+    for (int i = 0; i < m_journal_changed.size(); ++i) {
+        if (m_journal_changed[i] == ent) {
+            m_journal_changed.remove(i);
+            break;
+        }
+    }
+    m_journal_removed.add(ent->uid());
+}
+
+// Turn record: u64 turn, the rng, u8 game condition,
+// u32 count and the uids that left the field,
+// u32 count and per changed entity u8 kind, u32 uid and its save.
+// The player is always included, its direction resets every turn.
+void field::journal_turn() {
+    if (m_journal->checkpoint_interval() > 0 && m_turn % m_journal->checkpoint_interval() == 0) {
+        journal_checkpoint();
+        return;
+    }
+    journal_changed(m_player);
+
+    binary_writer& out = m_journal_buffer;
+    out.clear();
+    out.write<std::uint64_t>(m_turn);
+    m_rng.save(out);
+    out.write<std::uint8_t>((int) m_game_condition);
+    out.write<std::uint32_t>(m_journal_removed.size());
+    for (std::uint32_t uid : m_journal_removed)
+        out.write<std::uint32_t>(uid);
+    out.write<std::uint32_t>(m_journal_changed.size());
+    for (const entity* ent : m_journal_changed) {
+        out.write<std::uint8_t>(ent->kind());
+        out.write<std::uint32_t>(ent->uid());
+        ent->save(out);
+    }
+    m_journal->append_turn(out);
+    forget_journal_changes();
+}
+
+// Checkpoint record: the binary save, then the uids it does not store.
+void field::journal_checkpoint() {
+    binary_writer& out = m_journal_buffer;
+    out.clear();
+    save(out);
+    save_uids(out);
+    m_journal->write_checkpoint(out);
+    forget_journal_changes();
+}
+
+void field::forget_journal_changes() {
+    m_journal_changed.clear();
+    m_journal_removed.clear();
+}
+
+void field::save_uids(binary_writer& out) const {
+    out.write<std::uint64_t>(m_turn);
+    out.write<std::uint32_t>(m_next_uid);
+    out.write<std::uint32_t>(m_player->uid());
+    for (const enemy* en : m_enemies)
+        out.write<std::uint32_t>(en->uid());
+    for (const artifact* art : m_artifacts)
+        out.write<std::uint32_t>(art->uid());
+}
+
+void field::load_uids(binary_reader& in) {
+    m_turn = in.read<std::uint64_t>();
+    m_next_uid = in.read<std::uint32_t>();
+    m_player->set_uid(in.read<std::uint32_t>());
+    for (enemy* en : m_enemies)
+        en->set_uid(in.read<std::uint32_t>());
+    for (artifact* art : m_artifacts)
+        art->set_uid(in.read<std::uint32_t>());
+}
+
+// Entities keep their place in m_enemies and m_artifacts: the order is
+// the order they act in, so the replayed game goes on exactly like the
+// recorded one.
+void field::apply_turn(binary_reader& in) {
+    arena::scope entities(m_arena);
+    m_turn = in.read<std::uint64_t>();
+    m_rng.load(in);
+    m_game_condition = (game_condition) in.read<std::uint8_t>();
+    m_distances_actual = false;
+
+    // in the order they were removed in, that keeps the order of the rest
+    std::uint32_t removed = in.read<std::uint32_t>();
+    for (std::uint32_t i = 0; i < removed; ++i) {
+        std::uint32_t uid = in.read<std::uint32_t>();
+        int index;
+        if ((index = find_enemy(uid)) >= 0)
+            delete_enemy(index);
+        else if ((index = find_artifact(uid)) >= 0)
+            delete_artifact(index);
+        // else it came and went between two records
+    }
+
+    std::uint32_t changed = in.read<std::uint32_t>();
+    Vector<entity*> fresh (0);
+    try {
+        for (std::uint32_t i = 0; i < changed; ++i) {
+            auto kind = (entity::kind_type) in.read<std::uint8_t>();
+            std::uint32_t uid = in.read<std::uint32_t>();
+            entity* ent;
+            switch (kind) {
+                case entity::PLAYER:
+                    ent = new player{};
+                    break;
+                case entity::ENEMY:
+                    ent = new enemy(enemy::ZOMBIE);
+                    break;
+                case entity::ARTIFACT:
+                    ent = new artifact((artifact::artifact_id) -1);
+                    break;
+                default:
+                    throw load_error{};
+            }
+            fresh.add(ent);
+            ent->load(in);
+            check_on_ground(ent->coords());
+            ent->set_uid(uid);
+            m_next_uid = std::max(m_next_uid, uid + 1);
+        }
+    } catch (...) {
+        // none of them is in the field yet
+        for (entity* ent : fresh)
+            delete ent;
+        throw;
+    }
+
+    // lift every old version first, the new ones may take the cells they leave
+    for (entity* ent : fresh) {
+        const entity* old = nullptr;
+        int index;
+        if (ent->is<player>())
+            old = m_player;
+        else if (ent->is<enemy>() && (index = find_enemy(ent->uid())) >= 0)
+            old = m_enemies[index];
+        else if (ent->is<artifact>() && (index = find_artifact(ent->uid())) >= 0)
+            old = m_artifacts[index];
+        if (old == nullptr)
+            continue;
+        m_cells(old->coords().first, old->coords().second).set_entity(nullptr);
+        mark_dirty(old->coords());
+        if (old->is<enemy>())
+            on_enemy_left(old->coords());
+    }
+
+    // each new version needs a cell of its own
+    for (int i = 0; i < fresh.size(); ++i) {
+        bool taken = m_cells(fresh[i]->coords().first, fresh[i]->coords().second).get_entity() != nullptr;
+        for (int j = 0; j < i && !taken; ++j)
+            taken = fresh[j]->coords() == fresh[i]->coords();
+        if (taken) {
+            for (entity* ent : fresh)
+                delete ent;
+            throw load_error{};
+        }
+    }
+
+    for (entity* ent : fresh) {
+        int index;
+        if (ent->is<player>()) {
+            delete m_player;
+            m_player = (player*) ent;
+        } else if (ent->is<enemy>() && (index = find_enemy(ent->uid())) >= 0) {
+            delete m_enemies[index];
+            m_enemies[index] = (enemy*) ent;
+            on_enemy_entered(ent->coords());
+        } else if (ent->is<artifact>() && (index = find_artifact(ent->uid())) >= 0) {
+            delete m_artifacts[index];
+            m_artifacts[index] = (artifact*) ent;
+        } else if (ent->is<enemy>()) {
+            add_enemy((enemy*) ent);
+            continue;
+        } else {
+            add_artifact((artifact*) ent);
+            continue;
+        }
+        m_cells(ent->coords().first, ent->coords().second).set_entity(ent);
+        mark_dirty(ent->coords());
+    }
+}
+
+int field::find_enemy(std::uint32_t uid) const {
+    for (int i = 0; i < m_enemies.size(); ++i)
+        if (m_enemies[i]->uid() == uid)
+            return i;
+    return -1;
+}
+
+int field::find_artifact(std::uint32_t uid) const {
+    for (int i = 0; i < m_artifacts.size(); ++i)
+        if (m_artifacts[i]->uid() == uid)
+            return i;
+    return -1;
 }
\ No newline at end of file
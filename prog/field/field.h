@@ -7,7 +7,9 @@
 #include "../../lib/containers/vector/Vector.h"
 #include "../../lib/containers/matrix/Matrix.h"
 #include "../../lib/containers/queue/Queue.h"
-#include "../../lib/utils/type_utils.h"
+#include "../../lib/containers/bitset/Bitset.h"
+#include "../../lib/utils/arena/arena.h"
+#include "../../lib/utils/random/Pcg32.h"
 
 #include "../entities/characters/player/player.h"
 #include "../entities/characters/enemies/enemy.h"
@@ -16,6 +18,12 @@
 
 #include "../geometry/geo.h"
 #include "field_settings.h"
+#include "save_snapshot.h"
+#include "turn_journal.h"
+
+namespace replay {
+    class recorder;
+}
 
 enum class sygnal {
     UP,
@@ -57,22 +65,37 @@ public:
 
     static const Vector<field_template> field_templates;
 
-    static const int distance_unvisited = INT32_MAX; // must be big!!!
+    inline static const int distance_unvisited = INT32_MAX; // must be big!!!
 
 private:
 
     inline static const char *const SAVE_FILENAME = "field_save.txt";
+    inline static const char *const BINARY_SAVE_FILENAME = "field_save.bin";
+
+    inline static const char BINARY_SAVE_MAGIC[] = "GFLD";
+    // 1 also stored both distance matrices, 2 leaves them out,
+    // 3 stores the terrain instead of taking it from the template
+    inline static const std::uint32_t BINARY_SAVE_VERSION = 3;
+    inline static const std::uint32_t OLDEST_BINARY_SAVE_VERSION = 1;
 
     inline static const char *const UNKNOWN_SIGNAL_ERROR = "Unknown signal error.";
     inline static const char *const UNKNOWN_CELL_SYMBOL  = "Unknown cell symbol.";
+    inline static const char *const DISTANCES_MISMATCH_ERROR = "Incremental distances differ from full recompute.";
 
     std::shared_ptr<Logger> m_logger;
 
     int m_id = -1;
     int m_width = -1, m_height = -1;
     geo::i_point m_entry = { -1, -1 }, m_exit = { -1, -1 };
-    Matrix<cell*> m_cells {0,0};
+    Matrix<cell> m_cells {0,0};
+    Bitset m_walkable; // ground not taken by an enemy, indexed like m_cells
     Matrix<int> m_distances {0,0}, m_distances_throw_enemies {0,0};
+    mutable Queue<Pair<geo::i_point,int>> m_bfs_queue;
+
+    Pcg32 m_rng;
+
+    // storage of the entities below, created inside an arena::scope of it
+    arena m_arena;
 
     player* m_player = nullptr;
     Vector<enemy*> m_enemies = Vector<enemy*>(0);
@@ -80,11 +103,73 @@ private:
 
     bool m_instant_step_on_action = true;
 
+    unsigned long long m_turn = 0;   // steps taken by this field object, restarts included
+    std::uint32_t m_next_uid = 1;
+
+    // bumped whenever the terrain is rebuilt, so views can cache it
+    int m_terrain_generation = 0;
+
+    // the terrain as saved, cached for the generation it was encoded from
+    mutable std::shared_ptr<const std::string> m_saved_terrain;
+    mutable int m_saved_terrain_generation = -1;
+
+    std::shared_ptr<replay::recorder> m_recorder;
+
+    // entities changed and uids removed since the last journal record
+    std::shared_ptr<turn_journal> m_journal;
+    Vector<entity*> m_journal_changed = Vector<entity*>(0);
+    Vector<std::uint32_t> m_journal_removed = Vector<std::uint32_t>(0);
+    binary_writer m_journal_buffer;
+
+    // cells whose look changed since the last clear_dirty(), each listed once
+    Vector<geo::i_point> m_dirty_cells;
+    Bitset m_dirty_mask;
+    bool m_all_dirty = true;
+
+    bool m_incremental_distances = true;
+    bool m_distances_actual = false;
+
     game_condition m_game_condition = game_condition::RUNNING;
 
-    Vector<geo::i_point> get_neighbors(geo::i_point coords) const;
+    int index(geo::i_point coords) const;
+
+    neighbor_range get_neighbors(geo::i_point coords) const;
+
+    void reset_terrain();
+    void build_terrain();
+    void build_terrain(const char* types);
+    void build_adjacency();
+
+    bool occupied_by_enemy(geo::i_point coords) const;
+    void check_on_ground(geo::i_point coords) const;
+    void check_placeable(geo::i_point coords) const;
 
     void evaluate_distances();
+    void evaluate_distances(Matrix<int>& distances, bool throw_enemies) const;
+    void ensure_distances();
+
+    void release_distances(geo::i_point coords);
+    void block_distances(geo::i_point coords);
+    void check_distances() const;
+
+    void mark_dirty(geo::i_point coords);
+
+    void on_enemy_left(geo::i_point coords);
+    void on_enemy_entered(geo::i_point coords);
+
+    void assign_uid(entity* ent);
+
+    void journal_changed(entity* ent);
+    void journal_removed(const entity* ent);
+    void journal_turn();
+    void journal_checkpoint();
+    void forget_journal_changes();
+
+    void save_uids(binary_writer& out) const;
+    void load_uids(binary_reader& in);
+    void apply_turn(binary_reader& in);
+    int find_enemy(std::uint32_t uid) const;
+    int find_artifact(std::uint32_t uid) const;
 
     void move_character(character* c, geo::i_point coords);
 
@@ -98,8 +183,12 @@ private:
     void check_if_character_dead(character* c);
 
     void save();
+    void save_header(binary_writer& out) const;
+    void save_entities(binary_writer& out) const;
+    const std::shared_ptr<const std::string>& saved_terrain() const;
 
     void load(bool try_from_file = true);
+    void load(binary_reader& in, std::uint32_t version);
     void reload();
     void clear();
 
@@ -107,7 +196,8 @@ private:
 
 public:
 
-    field(int id, std::shared_ptr<Logger> logger = nullptr);
+    field(int id, std::shared_ptr<Logger> logger = nullptr, bool try_from_file = true,
+          std::uint64_t seed = Pcg32::default_seed);
     field(field_settings<0> settings, std::shared_ptr<Logger> logger = nullptr);
     field(field_settings<1> settings, std::shared_ptr<Logger> logger = nullptr);
     field(field_settings<2> settings, std::shared_ptr<Logger> logger = nullptr);
@@ -126,17 +216,39 @@ public:
     cell::cell_type get_cell_type(int x, int y) const;
 
     const player& get_player() const;
-    const Vector<enemy*> get_enemies() const;
-    const Vector<artifact*> get_artifacts() const;
+    const Vector<enemy*>& get_enemies() const;
+    const Vector<artifact*>& get_artifacts() const;
 
     geo::i_point get_entry_coords() const;
     geo::i_point get_exit_coords() const;
 
+    int terrain_generation() const;
+
+    const entity* get_occupant(int x, int y) const;
+
+    const Vector<geo::i_point>& get_dirty_cells() const;
+    bool all_dirty() const;
+    void clear_dirty();
+
     game_condition get_game_condition() const;
 
+    unsigned long long turn() const;
+
+    // when false, direction signals only turn the player and the
+    // caller drives time with sygnal::STEP (real-time mode)
+    bool instant_step_on_action() const;
+    void set_instant_step_on_action(bool instant);
+
+    const Pcg32& get_rng() const;
+    void seed(std::uint64_t seed);
+
+    bool incremental_distances() const;
+    void set_incremental_distances(bool incremental);
+
     void add_enemy(enemy* en);
     void add_artifact(artifact* art);
 
+    // the caller owns what remove_* returns, it may outlive the field
     [[nodiscard]] enemy* remove_enemy(int index);
     void delete_enemy(int index);
     [[nodiscard]] artifact* remove_artifact(int index);
@@ -147,11 +259,33 @@ public:
     [[nodiscard]] artifact* remove_artifact(artifact* ptr);
     void delete_artifact(artifact* ptr);
 
+    // cheap enough for the game thread: the terrain is shared, not copied
+    save_snapshot capture_save() const;
+    // writes field_save.bin atomically and durably, from any thread
+    static bool write_save(const save_snapshot& snap);
+
+    // hash of everything a save holds: fields with equal hashes play on identically
+    std::uint64_t state_hash() const;
+
+    // gets every signal from now on
+    std::shared_ptr<replay::recorder> get_recorder();
+    void set_recorder(std::shared_ptr<replay::recorder> recorder);
+
+    // writes a checkpoint right away, then a record after every turn
+    std::shared_ptr<turn_journal> get_journal();
+    void set_journal(std::shared_ptr<turn_journal> journal);
+
+    // the field as of the last complete turn in the journal; load_error if it
+    // holds no checkpoint or an impossible game, the field is then left as it was
+    void recover(const char* journal_filename);
+
     std::shared_ptr<Logger> get_logger();
     void set_logger(std::shared_ptr<Logger> logger);
 
     void save(std::ostream &out) const override;
     void load(std::istream &in) override;
+    void save(binary_writer &out) const override;
+    void load(binary_reader &in) override;
 };
 
 #endif //GAME_FIELD_H
\ No newline at end of file
@@ -1,15 +1,30 @@
 #ifndef GAME_FIELD_SETTINGS_H
 #define GAME_FIELD_SETTINGS_H
 
+#include <cstdint>
+
+#include "../../lib/utils/random/Pcg32.h"
+
 template <int field_id>
 class field_settings {
+    std::uint64_t m_seed;
 public:
+    field_settings(std::uint64_t seed = Pcg32::default_seed);
     int get_field_id();
+    std::uint64_t get_seed() const;
 };
 
+template <int field_id>
+field_settings<field_id>::field_settings(std::uint64_t seed) : m_seed(seed) {}
+
 template <int field_id>
 int field_settings<field_id>::get_field_id() {
     return field_id;
 }
 
+template <int field_id>
+std::uint64_t field_settings<field_id>::get_seed() const {
+    return m_seed;
+}
+
 #endif //GAME_FIELD_SETTINGS_H
\ No newline at end of file
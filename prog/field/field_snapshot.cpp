@@ -0,0 +1,53 @@
+#include "field_snapshot.h"
+
+namespace {
+
+    entity_snapshot make_entity_snapshot(const entity& ent, const field_snapshot::coords_map& previous_coords) {
+        entity_snapshot snap { ent.kind(), ent.subtype(), ent.coords(), ent.coords(), 0, 0 };
+        auto it = previous_coords.find(&ent);
+        if (it != previous_coords.end())
+            snap.m_previous_coords = it->second;
+        if (ent.is<character>()) {
+            snap.m_hp = ((const character&) ent).hp();
+            snap.m_max_hp = ((const character&) ent).max_hp();
+        }
+        return snap;
+    }
+
+}
+
+void field_snapshot::capture(field& f, unsigned long long sequence, const coords_map& previous_coords) {
+
+    m_sequence = sequence;
+
+    if (m_terrain_generation != f.terrain_generation()) {
+        m_terrain_generation = f.terrain_generation();
+        m_width = f.width();
+        m_height = f.height();
+        m_exit = f.get_exit_coords();
+        m_cells.resize(m_width * m_height);
+        for (int x = 0; x < m_width; ++x)
+            for (int y = 0; y < m_height; ++y)
+                m_cells[x * m_height + y] = f.get_cell_type(x, y);
+    }
+
+    m_entities.clear();
+    for (const artifact* art : f.get_artifacts())
+        m_entities.add(make_entity_snapshot(*art, previous_coords));
+    for (const enemy* en : f.get_enemies())
+        m_entities.add(make_entity_snapshot(*en, previous_coords));
+    m_entities.add(make_entity_snapshot(f.get_player(), previous_coords));
+
+    m_all_dirty = f.all_dirty();
+    m_dirty_cells.clear();
+    if (!m_all_dirty)
+        for (const auto& c : f.get_dirty_cells())
+            m_dirty_cells.add(c);
+    f.clear_dirty();
+
+    m_condition = f.get_game_condition();
+}
+
+cell::cell_type field_snapshot::cell_type(int x, int y) const {
+    return m_cells[x * m_height + y];
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#ifndef GAME_FIELD_SNAPSHOT_H
+#define GAME_FIELD_SNAPSHOT_H
+
+#include <unordered_map>
+
+#include "field.h"
+
+// What a view needs to draw one entity, copied out of the field.
+struct entity_snapshot {
+    entity::kind_type m_kind;
+    unsigned char m_subtype;
+    geo::i_point m_coords;
+    geo::i_point m_previous_coords; // where it was before the last tick, m_coords if unknown
+    int m_hp, m_max_hp;             // 0 for artifacts
+};
+
+// Immutable copy of the drawable state of a field, so that a view can draw it
+// on another thread while the field keeps going. Captured into a reused object:
+// the storage is kept and the terrain is copied only when its generation changes.
+struct field_snapshot {
+
+    unsigned long long m_sequence = 0; // number of the capture, views detect skipped ones by it
+    unsigned long long m_tick = 0;     // filled by whoever drives time: ticks done, m_previous_coords refer to the last one
+
+    int m_terrain_generation = -1;
+    int m_width = 0, m_height = 0;
+    geo::i_point m_exit = { -1, -1 };
+    Vector<cell::cell_type> m_cells; // column-major, like field::m_cells
+
+    Vector<entity_snapshot> m_entities; // artifacts, enemies, then the player: in drawing order
+
+    // cells changed since the previous capture; useless if that one was not seen
+    Vector<geo::i_point> m_dirty_cells;
+    bool m_all_dirty = true;
+
+    game_condition m_condition = game_condition::RUNNING;
+
+    using coords_map = std::unordered_map<const entity*, geo::i_point>;
+
+    // takes the field's dirty cells and clears them
+    void capture(field& f, unsigned long long sequence, const coords_map& previous_coords = {});
+
+    cell::cell_type cell_type(int x, int y) const;
+};
+
+#endif //GAME_FIELD_SNAPSHOT_H
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include "replay.h"
+
+#include <algorithm>
+
+#include "../../lib/utils/sarialization/varint.h"
+
+namespace replay {
+
+    static std::uint64_t read_varint(std::istream& in) {
+        std::uint64_t value;
+        if (!varint::read(in, value))
+            throw load_error{};
+        return value;
+    }
+
+    recorder::recorder(const char* filename, const field& f, int level, std::uint64_t seed, int checkpoint_interval)
+        : m_out(filename, std::ios::binary), m_checkpoint_interval(checkpoint_interval) {
+        m_out.write(magic, sizeof(magic));
+        m_out.put((char) version);
+        varint::write(m_out, level);
+        varint::write(m_out, seed);
+        varint::write(m_out, checkpoint_interval);
+
+        // a fresh level needs no state, the seed regenerates it
+        if (field(level, nullptr, false, seed).state_hash() == f.state_hash()) {
+            varint::write(m_out, 0);
+        } else {
+            binary_writer state;
+            f.save(state);
+            varint::write(m_out, state.size());
+            m_out.write(state.data(), (std::streamsize) state.size());
+        }
+    }
+
+    recorder::~recorder() {
+        flush();
+    }
+
+    void recorder::flush_run() {
+        if (m_run_length == 0)
+            return;
+        m_out.put((char) ((m_run_length - 1) << 3 | (int) m_run_signal));
+        m_run_length = 0;
+    }
+
+    void recorder::record(sygnal signal, const field& f) {
+        if (m_run_length == max_run || (m_run_length > 0 && signal != m_run_signal))
+            flush_run();
+        m_run_signal = signal;
+        ++m_run_length;
+
+        if (m_checkpoint_interval > 0 && ++m_signals % m_checkpoint_interval == 0) {
+            flush_run();
+            m_out.put((char) CHECKPOINT);
+            binary_writer hash;
+            hash.write<std::uint64_t>(f.state_hash());
+            m_out.write(hash.data(), (std::streamsize) hash.size());
+            m_out.flush();
+        }
+    }
+
+    void recorder::flush() {
+        flush_run();
+        m_out.flush();
+    }
+
+    reader::reader(std::istream& in) : m_in(in) {
+        char head[sizeof(magic) + 1];
+        m_in.read(head, sizeof(head));
+        if (m_in.fail() || !std::equal(magic, magic + sizeof(magic), head) || (unsigned char) head[sizeof(magic)] != version)
+            throw std::runtime_error(BAD_HEADER_ERROR);
+        m_header.m_level = (int) read_varint(m_in);
+        m_header.m_seed = read_varint(m_in);
+        m_header.m_checkpoint_interval = (int) read_varint(m_in);
+        // read in chunks, so a corrupt size runs into the end of the stream
+        // instead of allocating whatever it claims
+        std::uint64_t size = read_varint(m_in);
+        char chunk[4096];
+        while (size > 0) {
+            std::size_t n = (std::size_t) std::min<std::uint64_t>(size, sizeof(chunk));
+            m_in.read(chunk, (std::streamsize) n);
+            if (m_in.fail())
+                throw load_error{};
+            m_header.m_state.append(chunk, n);
+            size -= n;
+        }
+        if (m_header.m_level < 0 || m_header.m_level >= field::field_templates.size())
+            throw load_error{};
+    }
+
+    const header& reader::get_header() const {
+        return m_header;
+    }
+
+    bool reader::next(event& e) {
+        int byte = m_in.get();
+        if (byte == std::char_traits<char>::eof())
+            return false;
+        if (byte == CHECKPOINT) {
+            char hash[8];
+            m_in.read(hash, sizeof(hash));
+            if (m_in.fail())
+                throw load_error{};
+            e.m_checkpoint = true;
+            e.m_hash = binary_reader(hash, sizeof(hash)).read<std::uint64_t>();
+            return true;
+        }
+        if ((byte & 7) > (int) sygnal::RESTART)
+            throw load_error{};
+        e.m_checkpoint = false;
+        e.m_signal = (sygnal) (byte & 7);
+        e.m_count = (byte >> 3) + 1;
+        return true;
+    }
+
+    std::unique_ptr<field> reader::make_field() const {
+        auto f = std::make_unique<field>(m_header.m_level, nullptr, false, m_header.m_seed);
+        if (!m_header.m_state.empty()) {
+            binary_reader in (m_header.m_state.data(), m_header.m_state.size());
+            f->load(in);
+        }
+        return f;
+    }
+
+    result play(reader& r, field& f) {
+        result res;
+        unsigned long long first_turn = f.turn();
+        event e;
+        while (r.next(e)) {
+            if (e.m_checkpoint) {
+                ++res.m_checkpoints;
+                if (f.state_hash() != e.m_hash) {
+                    res.m_diverged = true;
+                    res.m_diverged_at = res.m_signals;
+                    break;
+                }
+                continue;
+            }
+            for (int i = 0; i < e.m_count; ++i)
+                f.send_sygnal(e.m_signal);
+            res.m_signals += e.m_count;
+        }
+        res.m_turns = f.turn() - first_turn;
+        return res;
+    }
+
+}
\ No newline at end of file
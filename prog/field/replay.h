@@ -0,0 +1,100 @@
+#ifndef GAME_REPLAY_H
+#define GAME_REPLAY_H
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "field.h"
+
+// Format of a replay, the signals a field got and the states they led to:
+//   header:  magic "GRPL", version byte, then varints:
+//            level id, seed, checkpoint interval, state size [, state bytes]
+//            The state is the binary save the recording started from, left
+//            out (size 0) when that is just the level generated from the seed.
+//   body:    one byte per entry
+//     signal      (count - 1) << 3 | sygnal          count times the same signal, 1..32
+//     CHECKPOINT  tag, then the 8 byte state hash    after every interval signals
+namespace replay {
+
+    inline constexpr char magic[4] = { 'G', 'R', 'P', 'L' };
+    inline constexpr unsigned char version = 1;
+
+    inline constexpr unsigned char CHECKPOINT = 7;
+    inline constexpr int max_run = 32;
+
+    inline constexpr int default_checkpoint_interval = 256;
+
+    struct header {
+        int m_level = 0;
+        std::uint64_t m_seed = 0;
+        int m_checkpoint_interval = default_checkpoint_interval;
+        std::string m_state;
+    };
+
+    struct event {
+        bool m_checkpoint;
+        sygnal m_signal;
+        int m_count;
+        std::uint64_t m_hash;
+    };
+
+    // Attached to a field, records every signal it gets.
+    class recorder {
+        std::ofstream m_out;
+        int m_checkpoint_interval;
+        unsigned long long m_signals = 0;
+        sygnal m_run_signal = sygnal::STEP;
+        int m_run_length = 0;
+
+        void flush_run();
+
+    public:
+        // f is the field as it is now, before the first recorded signal;
+        // level and seed are what it was created with
+        recorder(const char* filename, const field& f, int level, std::uint64_t seed,
+                 int checkpoint_interval = default_checkpoint_interval);
+        ~recorder();
+
+        void record(sygnal signal, const field& f);
+        void flush();
+    };
+
+    // Reads a replay back; throws load_error on a malformed one.
+    class reader {
+
+        inline static const char *const BAD_HEADER_ERROR = "Not a replay or unsupported version.";
+
+        std::istream& m_in;
+        header m_header;
+
+    public:
+
+        explicit reader(std::istream& in);
+
+        const header& get_header() const;
+
+        // false at the end of the replay
+        bool next(event& e);
+
+        // the field as it was when the recording started
+        std::unique_ptr<field> make_field() const;
+    };
+
+    struct result {
+        unsigned long long m_signals = 0;
+        unsigned long long m_turns = 0;
+        unsigned long long m_checkpoints = 0;
+        bool m_diverged = false;
+        unsigned long long m_diverged_at = 0; // signals played before the failed checkpoint
+    };
+
+    // Plays the rest of the replay on f as fast as it goes,
+    // stops at the first checkpoint whose hash differs.
+    result play(reader& r, field& f);
+
+}
+
+#endif //GAME_REPLAY_H
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "save_service.h"
+
+save_service::save_service(int autosave_interval)
+    : m_autosave_interval(autosave_interval), m_worker(&save_service::work, this) {}
+
+save_service::~save_service() {
+    {
+        std::lock_guard lock (m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_one();
+    m_worker.join();
+}
+
+void save_service::work() {
+    std::unique_lock lock (m_mutex);
+    while (true) {
+        m_wake.wait(lock, [this]() { return m_pending.has_value() || m_stop; });
+        if (!m_pending.has_value())
+            return;
+        save_snapshot snap = std::move(*m_pending);
+        m_pending.reset();
+        m_writing = true;
+        lock.unlock();
+
+        if (field::write_save(snap))
+            ++m_written;
+        else
+            ++m_failed;
+
+        lock.lock();
+        m_writing = false;
+        if (!m_pending.has_value())
+            m_idle.notify_all();
+    }
+}
+
+void save_service::save(const field& f) {
+    save_snapshot snap = f.capture_save();
+    m_last_saved_turn = snap.m_turn;
+    {
+        std::lock_guard lock (m_mutex);
+        m_pending = std::move(snap);
+    }
+    m_wake.notify_one();
+}
+
+void save_service::autosave(const field& f) {
+    if (m_autosave_interval > 0 && f.turn() >= m_last_saved_turn + m_autosave_interval)
+        save(f);
+}
+
+void save_service::flush() {
+    std::unique_lock lock (m_mutex);
+    m_idle.wait(lock, [this]() { return !m_pending.has_value() && !m_writing; });
+}
+
+int save_service::autosave_interval() const {
+    return m_autosave_interval;
+}
+
+void save_service::set_autosave_interval(int turns) {
+    m_autosave_interval = turns;
+}
+
+unsigned long long save_service::written() const {
+    return m_written;
+}
+
+unsigned long long save_service::failed() const {
+    return m_failed;
+}
\ No newline at end of file
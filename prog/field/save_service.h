@@ -0,0 +1,54 @@
+#ifndef GAME_SAVE_SERVICE_H
+#define GAME_SAVE_SERVICE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "field.h"
+#include "save_snapshot.h"
+
+// Saves the field on a worker thread. The calling thread only takes a
+// save_snapshot; encoding the file, fsync and the rename happen on the worker.
+// Requests that pile up while a save is written collapse into the newest one.
+class save_service {
+    std::mutex m_mutex;
+    std::condition_variable m_wake, m_idle;
+    std::optional<save_snapshot> m_pending;
+    bool m_writing = false;
+    bool m_stop = false;
+
+    int m_autosave_interval;
+    unsigned long long m_last_saved_turn = 0;
+
+    std::atomic<unsigned long long> m_written = 0, m_failed = 0;
+
+    std::thread m_worker;
+
+    void work();
+
+public:
+    // 0 turns the autosave off
+    explicit save_service(int autosave_interval = 0);
+    save_service(const save_service& other) = delete;
+    ~save_service();   // writes what is still pending
+
+    save_service& operator=(const save_service& other) = delete;
+
+    void save(const field& f);
+    // saves once the field is at least autosave_interval turns past the last save
+    void autosave(const field& f);
+
+    // blocks until every requested save is on disk
+    void flush();
+
+    int autosave_interval() const;
+    void set_autosave_interval(int turns);
+
+    unsigned long long written() const;
+    unsigned long long failed() const;
+};
+
+#endif //GAME_SAVE_SERVICE_H
\ No newline at end of file
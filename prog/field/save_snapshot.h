@@ -0,0 +1,19 @@
+#ifndef GAME_SAVE_SNAPSHOT_H
+#define GAME_SAVE_SNAPSHOT_H
+
+#include <memory>
+#include <string>
+
+#include "../../lib/utils/sarialization/binary_writer.h"
+
+// A binary save taken on the game thread and written out on another.
+// The terrain only changes when a level is built, so snapshots share
+// its bytes instead of each encoding a copy.
+struct save_snapshot {
+    binary_writer m_head;   // everything before the terrain
+    std::shared_ptr<const std::string> m_terrain;
+    binary_writer m_tail;   // the entities
+    unsigned long long m_turn = 0;
+};
+
+#endif //GAME_SAVE_SNAPSHOT_H
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include "turn_journal.h"
+
+#include "../../lib/utils/sarialization/atomic_file.h"
+#include "../../lib/utils/sarialization/crc32.h"
+
+static const std::size_t record_header_size = 4 + 4 + 1;
+
+turn_journal::reader::reader(const char* filename) {
+    if (!m_file.open(filename))
+        throw load_error{};
+    m_in = binary_reader(m_file.data(), m_file.size());
+    if (std::string(m_in.read_bytes(4), 4) != std::string(MAGIC, 4) || m_in.read<std::uint32_t>() != VERSION)
+        throw load_error{};
+}
+
+bool turn_journal::reader::next(record_type& type, binary_reader& payload) {
+    if (m_in.remaining() < record_header_size)
+        return false;
+    std::uint32_t size = m_in.read<std::uint32_t>();
+    std::uint32_t checksum = m_in.read<std::uint32_t>();
+    if (size >= m_in.remaining())
+        return false;
+    const char* body = m_in.read_bytes(size + 1);
+    if (crc32::compute(body, size + 1) != checksum)
+        return false;
+    type = (record_type) body[0];
+    payload = binary_reader(body + 1, size);
+    return true;
+}
+
+turn_journal::turn_journal(std::string filename, int checkpoint_interval)
+    : m_filename(std::move(filename)), m_checkpoint_interval(checkpoint_interval),
+      m_worker(&turn_journal::work, this) {}
+
+turn_journal::~turn_journal() {
+    {
+        std::lock_guard lock (m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_one();
+    m_worker.join();
+}
+
+const std::string& turn_journal::filename() const {
+    return m_filename;
+}
+
+int turn_journal::checkpoint_interval() const {
+    return m_checkpoint_interval;
+}
+
+void turn_journal::encode_record(binary_writer& out, record_type type, const char* payload, std::size_t size) {
+    out.write<std::uint32_t>(size);
+    std::size_t checksum_offset = out.size();
+    out.write<std::uint32_t>(0);
+    out.write<std::uint8_t>(type);
+    out.write_bytes(payload, size);
+    const char* body = out.data() + checksum_offset + 4;
+    out.write_at<std::uint32_t>(checksum_offset, crc32::compute(body, size + 1));
+}
+
+void turn_journal::work() {
+    binary_writer file;
+    std::unique_lock lock (m_mutex);
+    while (true) {
+        m_wake.wait(lock, [this]() { return m_pending.has_value() || m_stop; });
+        if (!m_pending.has_value())
+            return;
+        std::string payload = std::move(*m_pending);
+        m_pending.reset();
+        m_tail = std::move(m_pending_tail);
+        m_pending_tail.clear();
+        m_writing = true;
+        lock.unlock();
+
+        file.clear();
+        file.write_bytes(MAGIC, 4);
+        file.write<std::uint32_t>(VERSION);
+        encode_record(file, CHECKPOINT, payload.data(), payload.size());
+        bool ok = atomic_file::prepare(m_filename.c_str(), file.data(), file.size());
+
+        lock.lock();
+        // under the lock, so the file never lacks a record that was appended
+        if (ok)
+            ok = atomic_file::commit(m_filename.c_str(), m_tail.data(), m_tail.size());
+        m_out.close();
+        if (ok) {
+            m_out.open(m_filename, std::ios::binary | std::ios::app);
+            ok = m_out.is_open();
+        }
+        // on failure the old file keeps what it has, a complete journal up to
+        // this checkpoint's turn, and nothing more goes to it
+        if (!ok)
+            ++m_failed;
+        m_tail.clear();
+        m_writing = false;
+        m_syncing = true;
+        lock.unlock();
+
+        if (ok)
+            atomic_file::sync_directory(m_filename.c_str());
+
+        lock.lock();
+        m_syncing = false;
+        if (!m_pending.has_value())
+            m_idle.notify_all();
+    }
+}
+
+void turn_journal::write_checkpoint(const binary_writer& payload) {
+    {
+        std::lock_guard lock (m_mutex);
+        m_pending.emplace(payload.data(), payload.size());
+        m_pending_tail.clear();
+    }
+    m_wake.notify_one();
+}
+
+bool turn_journal::append_record(record_type type, const binary_writer& payload) {
+    m_record.clear();
+    encode_record(m_record, type, payload.data(), payload.size());
+    std::lock_guard lock (m_mutex);
+    // the turn of a checkpoint has no record, so what comes after one
+    // only goes to its file
+    if (m_pending.has_value()) {
+        m_pending_tail.append(m_record.data(), m_record.size());
+        return true;
+    }
+    if (m_writing) {
+        m_tail.append(m_record.data(), m_record.size());
+        return true;
+    }
+    m_out.write(m_record.data(), (std::streamsize) m_record.size());
+    m_out.flush();
+    return m_out.is_open() && !m_out.fail();
+}
+
+bool turn_journal::append_turn(const binary_writer& payload) {
+    return append_record(TURN, payload);
+}
+
+bool turn_journal::append_restart() {
+    return append_record(RESTART, binary_writer{});
+}
+
+void turn_journal::flush() {
+    std::unique_lock lock (m_mutex);
+    m_idle.wait(lock, [this]() { return !m_pending.has_value() && !m_writing && !m_syncing; });
+}
+
+unsigned long long turn_journal::failed() const {
+    return m_failed;
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#ifndef GAME_TURN_JOURNAL_H
+#define GAME_TURN_JOURNAL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "../../lib/utils/sarialization/binary_reader.h"
+#include "../../lib/utils/sarialization/binary_writer.h"
+#include "../../lib/utils/sarialization/mapped_file.h"
+
+// Append-only record of what each turn changed, with a full checkpoint
+// every checkpoint_interval turns; a checkpoint starts the file over, so
+// it never holds more than one checkpoint and the turns after it.
+//
+// File: char[4] magic, u32 version, then records of
+//   u32 payload size, u32 CRC-32 of type and payload, u8 type, payload.
+// Each record goes out in one write. A torn or corrupt record ends the
+// journal: a crash loses at most the turn that was being written.
+//
+// Turn records are appended on the calling thread. Checkpoints are written,
+// fsynced and renamed into place on a worker, like save_service does; until
+// one lands the old file stays as it was at the turn it was taken at.
+class turn_journal {
+public:
+
+    enum record_type : std::uint8_t {
+        CHECKPOINT = 1,
+        TURN = 2,
+        RESTART = 3     // the level was reloaded, replaying reloads it from the same rng state
+    };
+
+    inline static const char MAGIC[] = "GJRN";
+    inline static const std::uint32_t VERSION = 1;
+
+    inline static const int default_checkpoint_interval = 100;
+
+    class reader {
+        mapped_file m_file;
+        binary_reader m_in {nullptr, 0};
+
+    public:
+        // throws load_error if the file is missing or not a journal
+        explicit reader(const char* filename);
+
+        // false at the end or at the first broken record
+        bool next(record_type& type, binary_reader& payload);
+    };
+
+private:
+
+    std::string m_filename;
+    int m_checkpoint_interval;
+    binary_writer m_record;     // the calling thread's
+
+    std::mutex m_mutex;         // guards m_out and all below
+    std::condition_variable m_wake, m_idle;
+    std::ofstream m_out;
+    std::optional<std::string> m_pending;  // checkpoint payload for the worker
+    bool m_writing = false;     // a checkpoint is being written, records go to m_tail
+    bool m_syncing = false;     // its rename is being made durable
+    bool m_stop = false;
+    // records appended since the checkpoint being written / the pending one
+    // was queued, they follow it in its file
+    std::string m_tail, m_pending_tail;
+
+    std::atomic<unsigned long long> m_failed = 0;
+
+    std::thread m_worker;
+
+    static void encode_record(binary_writer& out, record_type type, const char* payload, std::size_t size);
+    bool append_record(record_type type, const binary_writer& payload);
+
+    void work();
+
+public:
+
+    explicit turn_journal(std::string filename, int checkpoint_interval = default_checkpoint_interval);
+    turn_journal(const turn_journal& other) = delete;
+    ~turn_journal();   // writes what is still pending
+
+    turn_journal& operator=(const turn_journal& other) = delete;
+
+    const std::string& filename() const;
+    int checkpoint_interval() const;
+
+    // the worker durably replaces the whole journal with this one checkpoint
+    void write_checkpoint(const binary_writer& payload);
+    bool append_turn(const binary_writer& payload);
+    bool append_restart();
+
+    // blocks until the newest checkpoint is on disk
+    void flush();
+
+    // checkpoints and reopens that went wrong
+    unsigned long long failed() const;
+};
+
+#endif //GAME_TURN_JOURNAL_H
\ No newline at end of file
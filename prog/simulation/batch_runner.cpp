@@ -0,0 +1,38 @@
+#include "batch_runner.h"
+
+void batch_stats::add(const simulation_result& result) {
+    m_games.fetch_add(1, std::memory_order_relaxed);
+    m_turns.fetch_add(result.m_turns, std::memory_order_relaxed);
+    switch (result.m_condition) {
+        case game_condition::WIN:
+            m_wins.fetch_add(1, std::memory_order_relaxed);
+            break;
+        case game_condition::LOSE:
+            m_loses.fetch_add(1, std::memory_order_relaxed);
+            break;
+        default:
+            m_timeouts.fetch_add(1, std::memory_order_relaxed);
+            break;
+    }
+    int min = m_min_turns.load(std::memory_order_relaxed);
+    while (result.m_turns < min && !m_min_turns.compare_exchange_weak(min, result.m_turns, std::memory_order_relaxed));
+    int max = m_max_turns.load(std::memory_order_relaxed);
+    while (result.m_turns > max && !m_max_turns.compare_exchange_weak(max, result.m_turns, std::memory_order_relaxed));
+}
+
+batch_runner::batch_runner(int threads) : m_pool(threads) {}
+
+int batch_runner::threads() const {
+    return m_pool.size();
+}
+
+void batch_runner::run(const batch_settings& settings, const policy_factory& policies, batch_stats& stats) {
+    for (int i = 0; i < settings.m_games; ++i) {
+        m_pool.submit([&settings, &policies, &stats, i]() {
+            std::uint64_t seed = settings.m_seed + i;
+            simulation sim (settings.m_level, policies(seed), settings.m_max_turns, seed);
+            stats.add(sim.run());
+        });
+    }
+    m_pool.wait();
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef GAME_BATCH_RUNNER_H
+#define GAME_BATCH_RUNNER_H
+
+#include <atomic>
+#include <functional>
+
+#include "../../lib/threads/ThreadPool.h"
+#include "simulation.h"
+
+struct batch_settings {
+    int m_level = 0;
+    int m_games = 1;
+    std::uint64_t m_seed = 0; // game i is played with seed m_seed + i
+    int m_max_turns = simulation::default_max_turns;
+};
+
+// Filled concurrently by the workers, so every counter is a relaxed atomic;
+// read it after run() returns.
+struct batch_stats {
+    std::atomic<long long> m_games = 0;
+    std::atomic<long long> m_wins = 0;
+    std::atomic<long long> m_loses = 0;
+    std::atomic<long long> m_timeouts = 0;
+    std::atomic<long long> m_turns = 0;
+    std::atomic<int> m_min_turns = INT32_MAX;
+    std::atomic<int> m_max_turns = 0;
+
+    void add(const simulation_result& result);
+};
+
+// Plays many independent games on a ThreadPool, one field per task.
+class batch_runner {
+
+public:
+
+    using policy_factory = std::function<move_policy(std::uint64_t seed)>;
+
+private:
+
+    ThreadPool m_pool;
+
+public:
+
+    // 0 threads means one per core
+    explicit batch_runner(int threads = 0);
+
+    int threads() const;
+
+    void run(const batch_settings& settings, const policy_factory& policies, batch_stats& stats);
+};
+
+#endif //GAME_BATCH_RUNNER_H
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include "move_policy.h"
+
+#include <memory>
+#include <stdexcept>
+
+#include "../../lib/containers/vector/Vector.h"
+
+move_policy move_policies::random(std::uint64_t seed) {
+    // own stream, so the moves do not correlate with the field's engine on the same seed
+    auto engine = std::make_shared<Pcg32>(seed, Pcg32::default_stream + 1);
+    return [engine](const field&) -> sygnal {
+        static const sygnal moves[] = { sygnal::UP, sygnal::DOWN, sygnal::LEFT, sygnal::RIGHT, sygnal::STEP };
+        return moves[engine->next(5)];
+    };
+}
+
+move_policy move_policies::scripted(const char* script) {
+    auto moves = std::make_shared<Vector<sygnal>>();
+    for (const char* c = script; *c != '\0'; ++c) {
+        switch (*c) {
+            case 'U':
+                moves->add(sygnal::UP);
+                break;
+            case 'D':
+                moves->add(sygnal::DOWN);
+                break;
+            case 'L':
+                moves->add(sygnal::LEFT);
+                break;
+            case 'R':
+                moves->add(sygnal::RIGHT);
+                break;
+            case 'S':
+                moves->add(sygnal::STEP);
+                break;
+            default:
+                throw std::runtime_error(UNKNOWN_MOVE_SYMBOL);
+        }
+    }
+    if (moves->empty())
+        moves->add(sygnal::STEP);
+    auto next = std::make_shared<int>(0);
+    return [moves, next](const field&) -> sygnal {
+        sygnal s = (*moves)[*next];
+        *next = (*next + 1) % moves->size();
+        return s;
+    };
+}
\ No newline at end of file
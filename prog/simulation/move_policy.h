@@ -0,0 +1,22 @@
+#ifndef GAME_MOVE_POLICY_H
+#define GAME_MOVE_POLICY_H
+
+#include <functional>
+
+#include "../field/field.h"
+
+// Decides the next signal for a field that is not driven by a user.
+using move_policy = std::function<sygnal(const field&)>;
+
+namespace move_policies {
+
+    inline static const char *const UNKNOWN_MOVE_SYMBOL = "Unknown move symbol.";
+
+    // uniformly random UP/DOWN/LEFT/RIGHT/STEP
+    move_policy random(std::uint64_t seed);
+
+    // repeats the script, one symbol per turn: U, D, L, R or S (step)
+    move_policy scripted(const char* script);
+}
+
+#endif //GAME_MOVE_POLICY_H
\ No newline at end of file
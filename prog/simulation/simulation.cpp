@@ -0,0 +1,21 @@
+#include "simulation.h"
+
+simulation::simulation(int level_id, move_policy policy, int max_turns, std::uint64_t seed)
+: m_field(level_id, nullptr, false, seed), m_policy(std::move(policy)), m_max_turns(max_turns) {}
+
+simulation_result simulation::run() {
+    int turns = 0;
+    while (m_field.get_game_condition() == game_condition::RUNNING && turns < m_max_turns) {
+        m_field.send_sygnal(m_policy(m_field));
+        ++turns;
+    }
+    return { m_field.get_game_condition(), turns };
+}
+
+field& simulation::get_field() {
+    return m_field;
+}
+
+const field& simulation::get_field() const {
+    return m_field;
+}
\ No newline at end of file
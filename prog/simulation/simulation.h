@@ -0,0 +1,37 @@
+#ifndef GAME_SIMULATION_H
+#define GAME_SIMULATION_H
+
+#include "../field/field.h"
+#include "move_policy.h"
+
+struct simulation_result {
+    game_condition m_condition;
+    int m_turns;
+};
+
+// Plays one field to WIN or LOSE without any window, as fast as possible.
+// Games that take longer than max_turns stop with RUNNING.
+class simulation {
+
+public:
+
+    inline static const int default_max_turns = 100000;
+
+private:
+
+    field m_field;
+    move_policy m_policy;
+    int m_max_turns;
+
+public:
+
+    simulation(int level_id, move_policy policy, int max_turns = default_max_turns,
+               std::uint64_t seed = Pcg32::default_seed);
+
+    simulation_result run();
+
+    field& get_field();
+    const field& get_field() const;
+};
+
+#endif //GAME_SIMULATION_H
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <getopt.h>
+
+#include "../prog/simulation/batch_runner.h"
+
+// Headless runner: plays --games games of --level with the given move policy
+// on --threads workers and reports the outcome and the simulation speed.
+//
+//   game_sim --level=5 --seed=42 --policy=random --games=100000 --threads=8
+//   game_sim --level=0 --policy=script:RRRDDS --max-turns=10000
+
+static void usage(const char* name) {
+    std::cerr << "usage: " << name
+              << " [--level=N] [--seed=N] [--policy=random|script:UDLRS...] [--games=N] [--max-turns=N] [--threads=N]\n";
+}
+
+int main(int argc, char** argv) {
+
+    int level = 0;
+    std::uint64_t seed = 0;
+    const char* policy = "random";
+    int games = 1;
+    int max_turns = simulation::default_max_turns;
+    int threads = 0;
+
+    const char* short_options = "l:s:p:g:t:j:h";
+
+    const option long_options[] = {
+            { "level", required_argument, nullptr, 'l' },
+            { "seed", required_argument, nullptr, 's' },
+            { "policy", required_argument, nullptr, 'p' },
+            { "games", required_argument, nullptr, 'g' },
+            { "max-turns", required_argument, nullptr, 't' },
+            { "threads", required_argument, nullptr, 'j' },
+            { "help", no_argument, nullptr, 'h' },
+            { nullptr, 0, nullptr, 0 }
+    };
+
+    int opchar;
+    int option_index;
+
+    while ((opchar = getopt_long_only(argc, argv, short_options, long_options, &option_index)) != -1) {
+        switch (opchar) {
+            case 'l':
+                level = std::atoi(optarg);
+                break;
+            case 's':
+                seed = std::strtoull(optarg, nullptr, 10);
+                break;
+            case 'p':
+                policy = optarg;
+                break;
+            case 'g':
+                games = std::atoi(optarg);
+                break;
+            case 't':
+                max_turns = std::atoi(optarg);
+                break;
+            case 'j':
+                threads = std::atoi(optarg);
+                break;
+            case 'h':
+                usage(argv[0]);
+                return 0;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (level < 0 || level >= field::field_templates.size()) {
+        std::cerr << "Unknown level " << level << ".\n";
+        return 1;
+    }
+
+    batch_runner::policy_factory policies;
+    try {
+        if (std::strncmp(policy, "script:", 7) == 0) {
+            move_policies::scripted(policy + 7); // fail here, not on a worker
+            policies = [policy](std::uint64_t) { return move_policies::scripted(policy + 7); };
+        } else if (std::strcmp(policy, "random") == 0) {
+            policies = [](std::uint64_t seed) { return move_policies::random(seed); };
+        } else {
+            std::cerr << "Unknown policy " << policy << ".\n";
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+
+    batch_settings settings { level, games, seed, max_turns };
+    batch_stats stats;
+    batch_runner runner (threads);
+
+    auto start = std::chrono::steady_clock::now();
+    runner.run(settings, policies, stats);
+    auto finish = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(finish - start).count();
+
+    std::cout << "level " << level << ", seed " << seed << ", policy " << policy
+              << ", threads " << runner.threads() << '\n'
+              << "games: " << stats.m_games << " (wins " << stats.m_wins << ", loses " << stats.m_loses
+              << ", timeouts " << stats.m_timeouts << ")\n"
+              << "turns: " << stats.m_turns << " (min " << (stats.m_games ? stats.m_min_turns.load() : 0)
+              << ", max " << stats.m_max_turns << ") in " << seconds << " s, "
+              << (seconds > 0 ? stats.m_turns / seconds : 0) << " turns/sec\n";
+}
\ No newline at end of file
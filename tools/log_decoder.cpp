@@ -0,0 +1,115 @@
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <getopt.h>
+
+#include "../lib/utils/logger/binary_log.h"
+
+// Renders a log written by BinaryLogger as text or CSV.
+//
+//   log_decoder game.glog
+//   log_decoder --format=csv game.glog > game.csv
+
+static void usage(const char* name) {
+    std::cerr << "usage: " << name << " [--format=text|csv] <log file>\n";
+}
+
+static void print_value(std::ostream& out, const binary_log::field& f, const char* separator) {
+    if (f.m_pair)
+        out << f.m_value[0] << separator << f.m_value[1];
+    else
+        out << f.m_value[0];
+}
+
+// [tick 12] update #3 enemy{ coords={ 4, 2 }, hp=40 }
+static void print_text(std::ostream& out, const binary_log::reader& r, const binary_log::event& e) {
+    out << "[tick " << e.m_tick << "] " << (e.m_spawn ? "spawn" : "update")
+        << " #" << e.m_id << ' ' << r.name(e.m_type) << "{ ";
+    for (int i = 0; i < e.m_fields.size(); ++i) {
+        const binary_log::field& f = e.m_fields[i];
+        if (i != 0)
+            out << ", ";
+        out << r.name(f.m_name) << '=';
+        if (f.m_pair)
+            out << "{ ";
+        print_value(out, f, ", ");
+        if (f.m_pair)
+            out << " }";
+    }
+    out << " }\n";
+}
+
+// one row per changed field: tick,event,id,type,field,value,second
+static void print_csv(std::ostream& out, const binary_log::reader& r, const binary_log::event& e) {
+    for (const binary_log::field& f : e.m_fields) {
+        out << e.m_tick << ',' << (e.m_spawn ? "spawn" : "update") << ',' << e.m_id << ','
+            << r.name(e.m_type) << ',' << r.name(f.m_name) << ',';
+        print_value(out, f, ",");
+        if (!f.m_pair)
+            out << ',';
+        out << '\n';
+    }
+}
+
+int main(int argc, char** argv) {
+
+    const char* short_options = "f:h";
+
+    const option long_options[] = {
+            { "format", required_argument, nullptr, 'f' },
+            { "help", no_argument, nullptr, 'h' },
+            { nullptr, 0, nullptr, 0 }
+    };
+
+    bool csv = false;
+
+    int opchar;
+    int option_index;
+
+    while ((opchar = getopt_long_only(argc, argv, short_options, long_options, &option_index)) != -1) {
+        switch (opchar) {
+            case 'f':
+                if (std::strcmp(optarg, "csv") == 0) {
+                    csv = true;
+                } else if (std::strcmp(optarg, "text") != 0) {
+                    std::cerr << "unknown format: " << optarg << '\n';
+                    return 1;
+                }
+                break;
+            case 'h':
+                usage(argv[0]);
+                return 0;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (optind != argc - 1) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    std::ifstream in (argv[optind], std::ios::binary);
+    if (!in) {
+        std::cerr << "cannot open " << argv[optind] << '\n';
+        return 1;
+    }
+
+    try {
+        binary_log::reader r (in);
+        binary_log::event e;
+        if (csv)
+            std::cout << "tick,event,id,type,field,value,second\n";
+        while (r.next(e)) {
+            if (csv)
+                print_csv(std::cout, r, e);
+            else
+                print_text(std::cout, r, e);
+        }
+    } catch (const std::exception& err) {
+        std::cout.flush();
+        std::cerr << argv[optind] << ": " << err.what() << '\n';
+        return 1;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <getopt.h>
+
+#include "../prog/field/replay.h"
+
+// Plays recorded sessions (main --record=FILE) back headless at full speed,
+// checks the state hashes stored along the way and reports the turn
+// throughput, so recorded traces work as a regression and speed corpus.
+//
+//   replay session.rpl
+//   replay --repeat=5 traces/*.rpl
+
+static void usage(const char* name) {
+    std::cerr << "usage: " << name << " [--repeat=N] <replay file>...\n";
+}
+
+int main(int argc, char** argv) {
+
+    int repeat = 1;
+
+    const char* short_options = "r:h";
+
+    const option long_options[] = {
+            { "repeat", required_argument, nullptr, 'r' },
+            { "help", no_argument, nullptr, 'h' },
+            { nullptr, 0, nullptr, 0 }
+    };
+
+    int opchar;
+    int option_index;
+
+    while ((opchar = getopt_long_only(argc, argv, short_options, long_options, &option_index)) != -1) {
+        switch (opchar) {
+            case 'r':
+                repeat = std::max(1, std::atoi(optarg));
+                break;
+            case 'h':
+                usage(argv[0]);
+                return 0;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (optind == argc) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    int failed = 0;
+    for (int i = optind; i < argc; ++i) {
+        std::ifstream file (argv[i], std::ios::binary);
+        if (!file) {
+            std::cerr << "cannot open " << argv[i] << '\n';
+            ++failed;
+            continue;
+        }
+        // read once, so that repeats time the game and not the disk
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        const std::string data = buffer.str();
+
+        try {
+            replay::result res;
+            double best = 0;
+            for (int r = 0; r < repeat; ++r) {
+                std::istringstream in (data);
+                replay::reader reader (in);
+                std::unique_ptr<field> f = reader.make_field();
+
+                auto start = std::chrono::steady_clock::now();
+                res = replay::play(reader, *f);
+                auto finish = std::chrono::steady_clock::now();
+
+                double ms = std::chrono::duration<double, std::milli>(finish - start).count();
+                if (r == 0 || ms < best)
+                    best = ms;
+                if (res.m_diverged)
+                    break;
+            }
+
+            std::cout << argv[i] << ": " << res.m_signals << " signals, " << res.m_turns << " turns, "
+                      << res.m_checkpoints << " checkpoints";
+            if (res.m_diverged) {
+                std::cout << ", DIVERGED after signal " << res.m_diverged_at << '\n';
+                ++failed;
+                continue;
+            }
+            std::cout << ", " << best << " ms";
+            if (best > 0)
+                std::cout << ", " << (unsigned long long) (res.m_turns / best * 1000) << " turns/s";
+            std::cout << '\n';
+        } catch (const std::exception& err) {
+            std::cout.flush();
+            std::cerr << argv[i] << ": " << err.what() << '\n';
+            ++failed;
+        }
+    }
+    return failed == 0 ? 0 : 1;
+}
\ No newline at end of file